@@ -24,6 +24,10 @@ function(build_erf_lib erf_lib_name)
     target_compile_definitions(${erf_lib_name} PUBLIC ERF_USE_MOISTURE)
   endif()
 
+  if(ERF_ENABLE_FAST_FLOAT)
+    target_compile_definitions(${erf_lib_name} PUBLIC ERF_USE_FAST_FLOAT)
+  endif()
+
   if(ERF_ENABLE_MULTIBLOCK)
     target_sources(${erf_lib_name} PRIVATE
                    ${SRC_DIR}/MultiBlockContainer.H
@@ -36,12 +40,14 @@ function(build_erf_lib erf_lib_name)
                    ${SRC_DIR}/IO/NCInterface.H
                    ${SRC_DIR}/IO/NCWpsFile.H
                    ${SRC_DIR}/IO/NCPlotFile.H
+                   ${SRC_DIR}/IO/ERF_WRFBdyStream.H
                    ${SRC_DIR}/IO/NCBuildFABs.cpp
                    ${SRC_DIR}/IO/NCInterface.cpp
                    ${SRC_DIR}/IO/NCPlotFile.cpp
                    ${SRC_DIR}/IO/NCCheckpoint.cpp
                    ${SRC_DIR}/IO/NCMultiFabFile.cpp
                    ${SRC_DIR}/IO/ReadFromWRFBdy.cpp
+                   ${SRC_DIR}/IO/ERF_WRFBdyStream.cpp
                    ${SRC_DIR}/IO/ReadFromWRFInput.cpp
                    ${SRC_DIR}/IO/NCColumnFile.cpp)
     target_compile_definitions(${erf_lib_name} PUBLIC ERF_USE_NETCDF)
@@ -88,7 +94,11 @@ function(build_erf_lib erf_lib_name)
        ${SRC_DIR}/BoundaryConditions/BoundaryConditions_zvel.cpp
        ${SRC_DIR}/BoundaryConditions/BoundaryConditions_bndryreg.cpp
        ${SRC_DIR}/BoundaryConditions/BoundaryConditions_wrfbdy.cpp
+       ${SRC_DIR}/BoundaryConditions/ERF_WRFBdyRelax.H
        ${SRC_DIR}/BoundaryConditions/ERF_FillPatch.cpp
+       ${SRC_DIR}/BoundaryConditions/ERF_FillPatcher.cpp
+       ${SRC_DIR}/BoundaryConditions/ERF_GhostExchange.cpp
+       ${SRC_DIR}/BoundaryConditions/ERF_FillTracker.cpp
        ${SRC_DIR}/BoundaryConditions/ERF_PhysBCFunct.cpp
        ${SRC_DIR}/BoundaryConditions/PlaneAverage.H
        ${SRC_DIR}/BoundaryConditions/VelPlaneAverage.H
@@ -96,6 +106,7 @@ function(build_erf_lib erf_lib_name)
        ${SRC_DIR}/IO/Checkpoint.cpp
        ${SRC_DIR}/IO/ERF_ReadBndryPlanes.H
        ${SRC_DIR}/IO/ERF_ReadBndryPlanes.cpp
+       ${SRC_DIR}/IO/ERF_BndryPlaneFile.H
        ${SRC_DIR}/IO/ERF_WriteBndryPlanes.H
        ${SRC_DIR}/IO/ERF_WriteBndryPlanes.cpp
        ${SRC_DIR}/IO/Plotfile.cpp
@@ -103,6 +114,8 @@ function(build_erf_lib erf_lib_name)
        ${SRC_DIR}/Advection/Advection.H
        ${SRC_DIR}/Advection/AdvectionSrcForMom.cpp
        ${SRC_DIR}/Advection/AdvectionSrcForState.cpp
+       ${SRC_DIR}/Advection/AdvectionSrcForTracers.cpp
+       ${SRC_DIR}/Advection/SemiLagrangianFlux.cpp
        ${SRC_DIR}/Advection/AdvectionSrcForMom_N.H
        ${SRC_DIR}/Advection/AdvectionSrcForMom_T.H
        ${SRC_DIR}/Diffusion/DiffusionSrcForMom_N.cpp
@@ -116,6 +129,8 @@ function(build_erf_lib erf_lib_name)
        ${SRC_DIR}/Diffusion/ComputeStress_T.cpp
        ${SRC_DIR}/Diffusion/ComputeStrain_N.cpp
        ${SRC_DIR}/Diffusion/ComputeStrain_T.cpp
+       ${SRC_DIR}/Diffusion/TileStress.cpp
+       ${SRC_DIR}/Diffusion/ImplicitVertDiff.cpp
        ${SRC_DIR}/Utils/ERF_Math.H
        ${SRC_DIR}/Utils/Microphysics_Utils.H
        ${SRC_DIR}/Utils/Interpolation.H
@@ -130,6 +145,7 @@ function(build_erf_lib erf_lib_name)
        ${SRC_DIR}/Utils/TerrainMetrics.H
        ${SRC_DIR}/Utils/TerrainMetrics.cpp
        ${SRC_DIR}/Utils/VelocityToMomentum.cpp
+       ${SRC_DIR}/Utils/ZeroGradientGhostCells.cpp
        ${SRC_DIR}/TimeIntegration/ERF_ComputeTimestep.cpp
        ${SRC_DIR}/TimeIntegration/ERF_TimeStepping.cpp
        ${SRC_DIR}/TimeIntegration/ERF_MRI.H
@@ -145,6 +161,15 @@ function(build_erf_lib erf_lib_name)
        ${SRC_DIR}/TimeIntegration/ERF_fast_rhs_N.cpp
        ${SRC_DIR}/TimeIntegration/ERF_fast_rhs_T.cpp
        ${SRC_DIR}/TimeIntegration/ERF_fast_rhs_MT.cpp
+       ${SRC_DIR}/TimeIntegration/ERF_fused_scalar_rhs_N.cpp
+       ${SRC_DIR}/TimeIntegration/ERF_fused_mom_rhs_N.cpp
+       ${SRC_DIR}/TimeIntegration/ERF_Workspace.H
+       ${SRC_DIR}/TimeIntegration/ERF_Workspace.cpp
+       ${SRC_DIR}/TimeIntegration/ERF_PoissonSolve.cpp
+       ${SRC_DIR}/TimeIntegration/ERF_Tracers.cpp
+       ${SRC_DIR}/TimeIntegration/ERF_TridiagonalSolve.H
+       ${SRC_DIR}/TimeIntegration/ERF_FastReal.H
+       ${SRC_DIR}/TimeIntegration/ERF_MRITableau.H
   )
 
   if(NOT "${erf_exe_name}" STREQUAL "erf_unit_tests")
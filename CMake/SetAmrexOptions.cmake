@@ -7,7 +7,7 @@ set(AMReX_OMP ${ERF_ENABLE_OPENMP})
 set(AMReX_PRECISION "${ERF_PRECISION}" CACHE STRING "Floating point precision" FORCE)
 set(AMReX_EB OFF)
 set(AMReX_FORTRAN_INTERFACES OFF)
-set(AMReX_LINEAR_SOLVERS OFF)
+set(AMReX_LINEAR_SOLVERS ON)
 set(AMReX_AMRDATA OFF)
 set(AMReX_PARTICLES OFF)
 set(AMReX_SENSEI OFF)
@@ -0,0 +1,29 @@
+#!/bin/bash
+#
+# Compare the cost of the compressible (acoustic substepping) and anelastic solvers
+# on the MOST ABL case. Both runs advance to t = 800 s; the anelastic run takes the
+# advective time step instead of the fixed dt = 0.2 s.
+#
+# Usage: ./run_anelastic_timing.sh [executable] [mpirun prefix]
+
+exe="${1:-./erf_abl}"
+launcher="$2"
+
+run_case()
+{
+    name="$1"
+    inputs="$2"
+    shift 2
+    $launcher $exe $inputs "$@" erf.plot_int_1=-1 erf.check_int=-1 &> $name.log
+    lastline=`tail -n 1 $name.log`
+    if [[ "$lastline" != "AMReX"*"finalized" ]]; then
+        echo "Case $name failed"
+        exit 1
+    fi
+    nsteps=`grep -c "ADVANCE from time" $name.log`
+    total=`grep "Total Time:" $name.log | awk '{print $3}'`
+    echo "$name: $nsteps steps, total time $total s"
+}
+
+run_case compressible inputs_most max_step=4000
+run_case anelastic    inputs_anelastic
@@ -0,0 +1,46 @@
+#!/usr/bin/env python
+"""
+Temporal self-convergence of the multirate integrator
+
+Run inputs_advecting_time_convergence with erf.fixed_dt = dt, dt/2 and dt/4
+(and the same stop_time) in three directories, then
+
+    python check_time_convergence.py run_dt run_dt2 run_dt4
+
+The observed order is log2 of the ratio of the differences between successive
+solutions at the final time.
+"""
+import sys
+import os
+import glob
+import numpy as np
+import yt
+
+fields = ['density', 'x_velocity', 'y_velocity', 'temp']
+
+try:
+    results_dirs = sys.argv[1:4]
+    assert len(results_dirs) == 3
+except AssertionError:
+    sys.exit('usage: check_time_convergence.py run_dt run_dt2 run_dt4')
+
+def final_solution(results_dir):
+    pltfiles = glob.glob(os.path.join(results_dir,'plt?????'))
+    pltfiles.sort()
+    print('Final solution:',pltfiles[-1])
+    ds = yt.load(pltfiles[-1])
+    level0 = ds.covering_grid(level=0, left_edge=ds.domain_left_edge, dims=ds.domain_dimensions)
+    return ds.current_time.value, {fld: level0[fld].value for fld in fields}
+
+solns = [final_solution(results_dir) for results_dir in results_dirs]
+
+times = [t for t,_ in solns]
+if np.max(np.abs(np.diff(times))) > 1e-12 * max(1.0, np.max(np.abs(times))):
+    sys.exit('final times differ: {}'.format(times))
+
+print('{:12s} {:>14s} {:>14s} {:>8s}'.format('field','|u_dt-u_dt2|','|u_dt2-u_dt4|','order'))
+for fld in fields:
+    d1 = np.sqrt(np.mean((solns[0][1][fld] - solns[1][1][fld])**2))
+    d2 = np.sqrt(np.mean((solns[1][1][fld] - solns[2][1][fld])**2))
+    order = np.log2(d1/d2) if d2 > 0 else np.inf
+    print('{:12s} {:14.6e} {:14.6e} {:8.3f}'.format(fld,d1,d2,order))
@@ -0,0 +1,40 @@
+#!/bin/bash
+#
+# Compare the cost of the advection kernels of two builds (e.g. before and after a change to
+# the kernels) on the ScalarAdvDiff_order2..6 regression inputs, refined to 64^3 cells. Build
+# both with TINY_PROFILE = TRUE so the time of each kernel is reported.
+#
+# Usage: ./run_advection_timing.sh <executable 1> <executable 2> [mpirun prefix]
+
+exe1="$1"
+exe2="$2"
+launcher="$3"
+
+if [[ -z "$exe1" || -z "$exe2" ]]; then
+    echo "Usage: $0 <executable 1> <executable 2> [mpirun prefix]"
+    exit 1
+fi
+
+kernels="AdvectionSrcForRhoAndTheta AdvectionSrcForScalars AdvectionSrcForMom"
+
+for order in 2 3 4 5 6; do
+    inputs="../../Tests/test_files/ScalarAdvDiff_order$order/ScalarAdvDiff_order$order.i"
+    for n in 1 2; do
+        if [[ $n == 1 ]]; then exe="$exe1"; else exe="$exe2"; fi
+        name="order${order}_exe$n"
+        $launcher $exe $inputs amr.n_cell="64 64 64" max_step=50 \
+                      erf.plot_int_1=-1 erf.check_int=-1 erf.v=0 &> $name.log
+        lastline=`tail -n 1 $name.log`
+        if [[ "$lastline" != "AMReX"*"finalized" ]]; then
+            echo "Case $name failed"
+            exit 1
+        fi
+        # Exclusive time (max over ranks) of each kernel
+        line="order $order, executable $n:"
+        for kernel in $kernels; do
+            time=`grep "^$kernel " $name.log | head -n 1 | awk '{print $5}'`
+            line="$line $kernel $time s"
+        done
+        echo "$line"
+    done
+done
@@ -0,0 +1,26 @@
+#!/bin/bash
+#
+# Measure the cost per passive tracer of the batched tracer advection with 1, 16 and 128
+# tracers, on the periodic fifth order advection case of the regression tests. Build with
+# TINY_PROFILE = TRUE so the time of the AdvectionSrcForTracers kernel is reported.
+#
+# Usage: ./run_tracer_scaling.sh [executable] [mpirun prefix]
+
+exe="${1:-./erf_scalar_advdiff}"
+launcher="$2"
+inputs="../../Tests/test_files/ScalarAdvDiff_tracers/ScalarAdvDiff_tracers.i"
+
+for ntracers in 1 16 128; do
+    name="tracers_$ntracers"
+    $launcher $exe $inputs erf.num_tracers=$ntracers amr.n_cell="64 64 64" max_step=50 \
+                  erf.plot_int_1=-1 erf.check_int=-1 erf.v=0 &> $name.log
+    lastline=`tail -n 1 $name.log`
+    if [[ "$lastline" != "AMReX"*"finalized" ]]; then
+        echo "Case $name failed"
+        exit 1
+    fi
+    # Exclusive time (max over ranks) of the tracer kernel
+    time=`grep "^AdvectionSrcForTracers " $name.log | head -n 1 | awk '{print $5}'`
+    per_tracer=`echo "$time / $ntracers" | bc -l`
+    printf "%4d tracers: %10s s in AdvectionSrcForTracers, %.6f s per tracer\n" $ntracers $time $per_tracer
+done
@@ -0,0 +1,110 @@
+#include <IndexDefines.H>
+#include <Advection.H>
+#include <Interpolation.H>
+
+using namespace amrex;
+
+/**
+ * Advect the passive tracers with the mass fluxes accumulated by AdvectionSrcForRhoAndTheta
+ *
+ *     tr_out = tr_old - dt * div(avg_mom * q_face),   q = tr_stage / rho
+ *
+ * The interpolation weights of all six faces, the fluxes, the metric terms and 1/rho are folded
+ * into one coefficient per stencil cell, once per cell. The loop over the tracers then only reads
+ * the stencil of tr_stage and tr_old and writes tr_out.
+ */
+template <int order, bool use_terrain, bool use_mf>
+void
+AdvectionSrcForTracers (const Box& bx, int ntracers, Real dt,
+                        const Array4<const Real>& avg_xmom, const Array4<const Real>& avg_ymom,
+                        const Array4<const Real>& avg_zmom,
+                        const Array4<const Real>& cons_stage,
+                        const Array4<const Real>& tr_old,
+                        const Array4<const Real>& tr_stage,
+                        const Array4<      Real>& tr_out,
+                        const Array4<const Real>& detJ,
+                        const GpuArray<Real, AMREX_SPACEDIM>& cellSizeInv,
+                        const Array4<const Real>& mf_m)
+{
+    BL_PROFILE_VAR("AdvectionSrcForTracers", AdvectionSrcForTracers);
+    auto dxInv = cellSizeInv[0], dyInv = cellSizeInv[1], dzInv = cellSizeInv[2];
+
+    constexpr int W = UpwindStencil<order>::width;
+    constexpr int H = W / 2;
+
+    amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+    {
+        Real invdetJ = use_terrain ? 1. / detJ(i,j,k) : 1.;
+        Real mfsq    = use_mf ? mf_m(i,j,0) * mf_m(i,j,0) : 1.;
+
+        Real xflux_lo = avg_xmom(i,j,k), xflux_hi = avg_xmom(i+1,j,k);
+        Real yflux_lo = avg_ymom(i,j,k), yflux_hi = avg_ymom(i,j+1,k);
+        Real zflux_lo = avg_zmom(i,j,k), zflux_hi = avg_zmom(i,j,k+1);
+
+        Real w_lo[W], w_hi[W];
+
+        // Coefficients of the cells i-H .. i+H (and likewise in y and z) in dt * div(flux),
+        //    with the center cell collected in cx[H]
+        Real cx[W+1], cy[W+1], cz[W+1];
+        for (int p = 0; p <= W; ++p) { cx[p] = 0.; cy[p] = 0.; cz[p] = 0.; }
+
+        Real fac = dt * invdetJ * dxInv * mfsq;
+        upwindFaceWeights<order>(xflux_lo, w_lo);
+        upwindFaceWeights<order>(xflux_hi, w_hi);
+        for (int p = 0; p < W; ++p) {
+            cx[p  ] -= fac * xflux_lo * w_lo[p];
+            cx[p+1] += fac * xflux_hi * w_hi[p];
+        }
+
+        fac = dt * invdetJ * dyInv * mfsq;
+        upwindFaceWeights<order>(yflux_lo, w_lo);
+        upwindFaceWeights<order>(yflux_hi, w_hi);
+        for (int p = 0; p < W; ++p) {
+            cy[p  ] -= fac * yflux_lo * w_lo[p];
+            cy[p+1] += fac * yflux_hi * w_hi[p];
+        }
+
+        fac = dt * invdetJ * dzInv;
+        upwindFaceWeights<order>(zflux_lo, w_lo);
+        upwindFaceWeights<order>(zflux_hi, w_hi);
+        for (int p = 0; p < W; ++p) {
+            cz[p  ] -= fac * zflux_lo * w_lo[p];
+            cz[p+1] += fac * zflux_hi * w_hi[p];
+        }
+
+        // Fold 1/rho into the coefficients so they act on rho * q directly
+        for (int p = 0; p <= W; ++p) {
+            if (p != H) {
+                cx[p] /= cons_stage(i-H+p,j,k,Rho_comp);
+                cy[p] /= cons_stage(i,j-H+p,k,Rho_comp);
+                cz[p] /= cons_stage(i,j,k-H+p,Rho_comp);
+            }
+        }
+        cx[H] = (cx[H] + cy[H] + cz[H]) / cons_stage(i,j,k,Rho_comp);
+
+        for (int n = 0; n < ntracers; ++n) {
+            Real div = cx[H] * tr_stage(i,j,k,n);
+            for (int p = 0; p <= W; ++p) {
+                if (p != H) {
+                    div += cx[p] * tr_stage(i-H+p,j,k,n)
+                         + cy[p] * tr_stage(i,j-H+p,k,n)
+                         + cz[p] * tr_stage(i,j,k-H+p,n);
+                }
+            }
+            tr_out(i,j,k,n) = tr_old(i,j,k,n) - div;
+        }
+    });
+}
+
+namespace {
+struct SelectAdvectionSrcForTracers {
+    template <int order, bool use_terrain, bool use_mf>
+    static AdvectionSrcForTracersFn get () { return &AdvectionSrcForTracers<order,use_terrain,use_mf>; }
+};
+}
+
+AdvectionSrcForTracersFn
+select_AdvectionSrcForTracers (int spatial_order, bool use_terrain, bool use_mf)
+{
+    return select_advection_kernel<SelectAdvectionSrcForTracers>(spatial_order, use_terrain, use_mf);
+}
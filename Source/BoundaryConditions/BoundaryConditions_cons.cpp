@@ -14,21 +14,19 @@ using namespace amrex;
 // bccomp is the index into both domain_bcs_type_bcr and bc_extdir_vals for icomp = 0  --
 //     so this follows the BCVars enum
 //
+// bcrs and bc_ptr are the host and device copies of the BCRecs of this box (components 0 to
+//     icomp+ncomp-1), taken from the boundary work list of the level
+//
 void ERFPhysBCFunct::impose_cons_bcs (const Array4<Real>& dest_arr, const Box& bx, const Box& domain,
                                       const Array4<Real const>& z_nd,
                                       const GpuArray<Real,AMREX_SPACEDIM> dxInv,
+                                      const BCRec* bcrs, const BCRec* bc_ptr,
                                       int icomp, int ncomp, Real /*time*/, int bccomp)
 {
     BL_PROFILE_VAR("impose_cons_bcs()",impose_cons_bcs);
     const auto& dom_lo = amrex::lbound(domain);
     const auto& dom_hi = amrex::ubound(domain);
 
-    // Based on BCRec for the domain, we need to make BCRec for this Box
-    // bccomp is used as starting index for m_domain_bcs_type
-    //      0 is used as starting index for bcrs
-    Vector<BCRec> bcrs(icomp+ncomp);
-    amrex::setBC(bx, domain, bccomp, 0, icomp+ncomp, m_domain_bcs_type, bcrs);
-
     // xlo: ori = 0
     // ylo: ori = 1
     // zlo: ori = 2
@@ -36,14 +34,6 @@ void ERFPhysBCFunct::impose_cons_bcs (const Array4<Real>& dest_arr, const Box& b
     // yhi: ori = 4
     // zhi: ori = 5
 
-    amrex::Gpu::DeviceVector<BCRec> bcrs_d(icomp+ncomp);
-#ifdef AMREX_USE_GPU
-    Gpu::htod_memcpy_async(bcrs_d.data(), bcrs.data(), sizeof(BCRec)*(icomp+ncomp));
-#else
-    std::memcpy(bcrs_d.data(), bcrs.data(), sizeof(BCRec)*(icomp+ncomp));
-#endif
-    const amrex::BCRec* bc_ptr = bcrs_d.data();
-
     GpuArray<GpuArray<Real, AMREX_SPACEDIM*2>,AMREX_SPACEDIM+NVAR> l_bc_extdir_vals_d;
 
     for (int i = 0; i < icomp+ncomp; i++)
@@ -261,5 +251,4 @@ void ERFPhysBCFunct::impose_cons_bcs (const Array4<Real>& dest_arr, const Box& b
             } // foextrap
         } // ncomp
     } // m_z_phys_nd
-    Gpu::streamSynchronize();
 }
@@ -22,12 +22,20 @@ ERF::fill_from_wrfbdy (const Vector<MultiFab*>& mfs, const Real time)
     const auto& dom_lo = amrex::lbound(domain);
     const auto& dom_hi = amrex::ubound(domain);
 
+    // Bring in the time levels around time (erf.wrfbdy_streaming)
+    if (wrfbdy_stream) {
+        wrfbdy_stream->update(time, bdy_data_xlo, bdy_data_xhi, bdy_data_ylo, bdy_data_yhi);
+    }
+
     Real dT = bdy_time_interval;
 
     int n_time = static_cast<int>(time / dT);
     amrex::Real alpha = (time - n_time * dT) / dT;
     amrex::Real oma   = 1.0 - alpha;
 
+    // Width of the specified zone
+    const int nset = wrfbdy_set_width;
+
     int ivar;
 
     for (int var_idx = 0; var_idx < Vars::NumTypes; ++var_idx)
@@ -68,12 +76,15 @@ ERF::fill_from_wrfbdy (const Vector<MultiFab*>& mfs, const Real time)
           for (MFIter mfi(mf); mfi.isValid(); ++mfi)
           {
             const Array4<Real>& dest_arr = mf.array(mfi);
-            Box bx = mfi.validbox();
+
+            // Only the part of the domain edges in this FAB (and in the boundary data, which
+            //    with erf.wrfbdy_streaming only covers the FABs on this rank)
+            const Box& bx = mf[mfi].box();
 
             // x-faces
             {
                 Box bx_xlo(bx);
-                bx_xlo.setSmall(0,dom_lo.x); bx_xlo.setBig(0,dom_lo.x);
+                bx_xlo.setSmall(0,dom_lo.x); bx_xlo.setBig(0,dom_lo.x+nset-1);
                 bx_xlo.setSmall(1,dom_lo.y); bx_xlo.setBig(1,dom_hi.y);
                 bx_xlo.setSmall(2,dom_lo.z); bx_xlo.setBig(2,dom_hi.z);
 
@@ -82,11 +93,14 @@ ERF::fill_from_wrfbdy (const Vector<MultiFab*>& mfs, const Real time)
                 bx_xhi.setSmall(2,dom_lo.z); bx_xhi.setBig(2,dom_hi.z);
 
                 if (var_idx == Vars::xvel) {
-                    bx_xhi.setSmall(0,dom_hi.x+1); bx_xhi.setBig(0,dom_hi.x+1);
+                    bx_xhi.setSmall(0,dom_hi.x+2-nset); bx_xhi.setBig(0,dom_hi.x+1);
                 } else {
-                    bx_xhi.setSmall(0,dom_hi.x); bx_xhi.setBig(0,dom_hi.x);
+                    bx_xhi.setSmall(0,dom_hi.x+1-nset); bx_xhi.setBig(0,dom_hi.x);
                 }
 
+                bx_xlo &= bx & bdy_data_xlo[n_time][ivar+nv].box();
+                bx_xhi &= bx & bdy_data_xhi[n_time][ivar+nv].box();
+
                 ParallelFor(
                   bx_xlo, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int )
                   {
@@ -105,7 +119,7 @@ ERF::fill_from_wrfbdy (const Vector<MultiFab*>& mfs, const Real time)
             {
                 Box bx_ylo(bx);
                 bx_ylo.setSmall(0,dom_lo.x); bx_ylo.setBig(0,dom_hi.x);
-                bx_ylo.setSmall(1,dom_lo.y); bx_ylo.setBig(1,dom_lo.y);
+                bx_ylo.setSmall(1,dom_lo.y); bx_ylo.setBig(1,dom_lo.y+nset-1);
                 bx_ylo.setSmall(2,dom_lo.z); bx_ylo.setBig(2,dom_hi.z);
 
                 Box bx_yhi(bx);
@@ -113,11 +127,14 @@ ERF::fill_from_wrfbdy (const Vector<MultiFab*>& mfs, const Real time)
                 bx_yhi.setSmall(2,dom_lo.z); bx_yhi.setBig(2,dom_hi.z);
 
                 if (var_idx == Vars::yvel) {
-                    bx_yhi.setSmall(1,dom_hi.y+1); bx_yhi.setBig(1,dom_hi.y+1);
+                    bx_yhi.setSmall(1,dom_hi.y+2-nset); bx_yhi.setBig(1,dom_hi.y+1);
                 } else {
-                    bx_yhi.setSmall(1,dom_hi.y); bx_yhi.setBig(1,dom_hi.y);
+                    bx_yhi.setSmall(1,dom_hi.y+1-nset); bx_yhi.setBig(1,dom_hi.y);
                 }
 
+                bx_ylo &= bx & bdy_data_ylo[n_time][ivar+nv].box();
+                bx_yhi &= bx & bdy_data_yhi[n_time][ivar+nv].box();
+
                 ParallelFor(
                   bx_ylo, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int )
                   {
@@ -135,4 +152,190 @@ ERF::fill_from_wrfbdy (const Vector<MultiFab*>& mfs, const Real time)
         } // nv
     } // var_idx
 }
+
+//
+// Find where the relaxation zone lies on the level-0 grids ba, dm
+//
+void
+ERF::define_wrfbdy_relax_zone (const BoxArray& ba, const DistributionMapping& dm)
+{
+    const Box& domain = geom[0].Domain();
+    const auto& dom_lo = amrex::lbound(domain);
+    const auto& dom_hi = amrex::ubound(domain);
+
+    // Points at distances nlo to nhi from a face of the domain are relaxed
+    const int nlo = wrfbdy_set_width;
+    const int nhi = wrfbdy_width - 2;
+
+    Vector<Box> bands(4);
+    bands[WRFBdyTypes::x_lo] = Box(IntVect(dom_lo.x+nlo, dom_lo.y    , dom_lo.z), IntVect(dom_lo.x+nhi, dom_hi.y    , dom_hi.z));
+    bands[WRFBdyTypes::x_hi] = Box(IntVect(dom_hi.x-nhi, dom_lo.y    , dom_lo.z), IntVect(dom_hi.x-nlo, dom_hi.y    , dom_hi.z));
+    bands[WRFBdyTypes::y_lo] = Box(IntVect(dom_lo.x    , dom_lo.y+nlo, dom_lo.z), IntVect(dom_hi.x    , dom_lo.y+nhi, dom_hi.z));
+    bands[WRFBdyTypes::y_hi] = Box(IntVect(dom_lo.x    , dom_hi.y-nhi, dom_lo.z), IntVect(dom_hi.x    , dom_hi.y-nlo, dom_hi.z));
+
+    WRFBdyRelaxZone& zone = wrfbdy_relax_zone;
+    zone.ba = ba;
+    zone.dm = dm;
+    zone.cc.clear();    zone.cc.resize(ba.size());
+    zone.xface.clear(); zone.xface.resize(ba.size());
+    zone.yface.clear(); zone.yface.resize(ba.size());
+
+    for (MFIter mfi(ba, dm); mfi.isValid(); ++mfi)
+    {
+        const Box& vbx = mfi.validbox();
+        const int idx = mfi.index();
+
+        for (int bt = 0; bt < 4; ++bt)
+        {
+            Box cbx = vbx & bands[bt];
+            Box xbx = amrex::surroundingNodes(vbx,0) & amrex::surroundingNodes(bands[bt],0);
+            Box ybx = amrex::surroundingNodes(vbx,1) & amrex::surroundingNodes(bands[bt],1);
+            if (cbx.ok()) zone.cc[idx].push_back(std::make_pair(cbx,bt));
+            if (xbx.ok()) zone.xface[idx].push_back(std::make_pair(xbx,bt));
+            if (ybx.ok()) zone.yface[idx].push_back(std::make_pair(ybx,bt));
+        }
+    }
+
+    // WRF's linear ramp, from 1 next to the specified zone down to 0 at the edge of the zone
+    Vector<Real> weight(wrfbdy_width, 0.0);
+    for (int n = nlo; n < wrfbdy_width; ++n) {
+        weight[n] = static_cast<Real>(wrfbdy_width - 1 - n) / static_cast<Real>(wrfbdy_width - nlo - 1);
+    }
+    zone.weight.resize(wrfbdy_width);
+    Gpu::copy(Gpu::hostToDevice, weight.begin(), weight.end(), zone.weight.begin());
+}
+
+//
+// Add to S_rhs the tendencies that relax S_data towards the wrfbdy data in the relaxation zone,
+// following WRF: F1 * d - F2 * del2(d), where d is the difference between the boundary data
+// at time and the state, F1 = w / (10 dt), F2 = w / (50 dt) and w is the weight at the
+// distance from the domain edge
+//
+void
+ERF::wrfbdy_relaxation (Vector<MultiFab>& S_rhs, const Vector<MultiFab>& S_data,
+                        const Real time, const Real dt)
+{
+    if (wrfbdy_width - wrfbdy_set_width < 2) return;
+
+    // Bring in the time levels around time (erf.wrfbdy_streaming)
+    if (wrfbdy_stream) {
+        wrfbdy_stream->update(time, bdy_data_xlo, bdy_data_xhi, bdy_data_ylo, bdy_data_yhi);
+    }
+
+    const BoxArray& ba            = S_rhs[IntVar::cons].boxArray();
+    const DistributionMapping& dm = S_rhs[IntVar::cons].DistributionMap();
+    if (wrfbdy_relax_zone.ba != ba || wrfbdy_relax_zone.dm != dm) {
+        define_wrfbdy_relax_zone(ba, dm);
+    }
+
+    const Box& domain = geom[0].Domain();
+    const auto& dom_lo = amrex::lbound(domain);
+    const auto& dom_hi = amrex::ubound(domain);
+
+    Real dT = bdy_time_interval;
+
+    int n_time = static_cast<int>(time / dT);
+    amrex::Real alpha = (time - n_time * dT) / dT;
+    amrex::Real oma   = 1.0 - alpha;
+
+    const int nlo = wrfbdy_set_width;
+    const int nhi = wrfbdy_width - 2;
+
+    const Real F1 = 1.0 / (10.0 * dt);
+    const Real F2 = 1.0 / (50.0 * dt);
+    const Real* weight = wrfbdy_relax_zone.weight.data();
+
+    // In WRFBdyTypes order
+    const Vector<Vector<FArrayBox>>* bdy_data[4] = {&bdy_data_xlo, &bdy_data_xhi, &bdy_data_ylo, &bdy_data_yhi};
+
+    for (MFIter mfi(S_rhs[IntVar::cons]); mfi.isValid(); ++mfi)
+    {
+        const int idx = mfi.index();
+
+        const Array4<Real>& cell_rhs  = S_rhs[IntVar::cons].array(mfi);
+        const Array4<Real>& rho_u_rhs = S_rhs[IntVar::xmom].array(mfi);
+        const Array4<Real>& rho_v_rhs = S_rhs[IntVar::ymom].array(mfi);
+
+        const Array4<Real const>& cell_data = S_data[IntVar::cons].const_array(mfi);
+        const Array4<Real const>& rho_u     = S_data[IntVar::xmom].const_array(mfi);
+        const Array4<Real const>& rho_v     = S_data[IntVar::ymom].const_array(mfi);
+
+        // rho and rho theta
+        for (const auto& zb : wrfbdy_relax_zone.cc[idx])
+        {
+            const int bt = zb.second;
+            const auto& r_n    = (*bdy_data[bt])[n_time  ][WRFBdyVars::R].const_array();
+            const auto& r_np1  = (*bdy_data[bt])[n_time+1][WRFBdyVars::R].const_array();
+            const auto& rt_n   = (*bdy_data[bt])[n_time  ][WRFBdyVars::T].const_array();
+            const auto& rt_np1 = (*bdy_data[bt])[n_time+1][WRFBdyVars::T].const_array();
+
+            ParallelFor(zb.first, [=] AMREX_GPU_DEVICE (int i, int j, int k)
+            {
+                int n = wrfbdy_zone_dist(i, j, dom_lo.x, dom_hi.x, dom_lo.y, dom_hi.y, bt);
+                if (n < nlo || n > nhi) return;
+
+                auto d_r = [=] (int ii, int jj) {
+                    return oma * r_n(ii,jj,k) + alpha * r_np1(ii,jj,k) - cell_data(ii,jj,k,Rho_comp);
+                };
+                auto d_rt = [=] (int ii, int jj) {
+                    return oma * rt_n(ii,jj,k) + alpha * rt_np1(ii,jj,k) - cell_data(ii,jj,k,RhoTheta_comp);
+                };
+
+                Real d0 = d_r(i,j);
+                Real del2 = d_r(i+1,j) + d_r(i-1,j) + d_r(i,j+1) + d_r(i,j-1) - 4.0 * d0;
+                cell_rhs(i,j,k,Rho_comp) += weight[n] * (F1 * d0 - F2 * del2);
+
+                d0 = d_rt(i,j);
+                del2 = d_rt(i+1,j) + d_rt(i-1,j) + d_rt(i,j+1) + d_rt(i,j-1) - 4.0 * d0;
+                cell_rhs(i,j,k,RhoTheta_comp) += weight[n] * (F1 * d0 - F2 * del2);
+            });
+        }
+
+        // x-momentum, relaxed towards the current density times the boundary velocity
+        for (const auto& zb : wrfbdy_relax_zone.xface[idx])
+        {
+            const int bt = zb.second;
+            const auto& u_n   = (*bdy_data[bt])[n_time  ][WRFBdyVars::U].const_array();
+            const auto& u_np1 = (*bdy_data[bt])[n_time+1][WRFBdyVars::U].const_array();
+
+            ParallelFor(zb.first, [=] AMREX_GPU_DEVICE (int i, int j, int k)
+            {
+                int n = wrfbdy_zone_dist(i, j, dom_lo.x, dom_hi.x+1, dom_lo.y, dom_hi.y, bt);
+                if (n < nlo || n > nhi) return;
+
+                auto d_ru = [=] (int ii, int jj) {
+                    Real rho_face = 0.5 * (cell_data(ii-1,jj,k,Rho_comp) + cell_data(ii,jj,k,Rho_comp));
+                    return rho_face * (oma * u_n(ii,jj,k) + alpha * u_np1(ii,jj,k)) - rho_u(ii,jj,k);
+                };
+
+                Real d0 = d_ru(i,j);
+                Real del2 = d_ru(i+1,j) + d_ru(i-1,j) + d_ru(i,j+1) + d_ru(i,j-1) - 4.0 * d0;
+                rho_u_rhs(i,j,k) += weight[n] * (F1 * d0 - F2 * del2);
+            });
+        }
+
+        // y-momentum
+        for (const auto& zb : wrfbdy_relax_zone.yface[idx])
+        {
+            const int bt = zb.second;
+            const auto& v_n   = (*bdy_data[bt])[n_time  ][WRFBdyVars::V].const_array();
+            const auto& v_np1 = (*bdy_data[bt])[n_time+1][WRFBdyVars::V].const_array();
+
+            ParallelFor(zb.first, [=] AMREX_GPU_DEVICE (int i, int j, int k)
+            {
+                int n = wrfbdy_zone_dist(i, j, dom_lo.x, dom_hi.x, dom_lo.y, dom_hi.y+1, bt);
+                if (n < nlo || n > nhi) return;
+
+                auto d_rv = [=] (int ii, int jj) {
+                    Real rho_face = 0.5 * (cell_data(ii,jj-1,k,Rho_comp) + cell_data(ii,jj,k,Rho_comp));
+                    return rho_face * (oma * v_n(ii,jj,k) + alpha * v_np1(ii,jj,k)) - rho_v(ii,jj,k);
+                };
+
+                Real d0 = d_rv(i,j);
+                Real del2 = d_rv(i+1,j) + d_rv(i-1,j) + d_rv(i,j+1) + d_rv(i,j-1) - 4.0 * d0;
+                rho_v_rhs(i,j,k) += weight[n] * (F1 * d0 - F2 * del2);
+            });
+        }
+    } // mfi
+}
 #endif
@@ -7,6 +7,34 @@ using namespace amrex;
 
 PhysBCFunctNoOp null_bc;
 
+namespace {
+
+//
+// Fill the valid region of "mf" at the given time from the old and new state data, as
+//    FillPatchSingleLevel does before it fills the ghost cells; mf must have the same grids
+//    as the state data, and is left alone if it is the state data itself
+//
+void
+fill_valid_at_time (MultiFab& mf, const MultiFab& old_mf, const MultiFab& new_mf,
+                    Real t_old, Real t_new, Real time)
+{
+    if (&mf == &old_mf || &mf == &new_mf) return;
+
+    const int ncomp = mf.nComp();
+    if (time == t_old) {
+        MultiFab::Copy(mf, old_mf, 0, 0, ncomp, 0);
+    } else if (time == t_new) {
+        MultiFab::Copy(mf, new_mf, 0, 0, ncomp, 0);
+    } else if (!amrex::almostEqual(t_old, t_new)) {
+        MultiFab::LinComb(mf, (t_new-time)/(t_new-t_old), old_mf, 0,
+                              (time-t_old)/(t_new-t_old), new_mf, 0, 0, ncomp, 0);
+    } else {
+        MultiFab::Copy(mf, old_mf, 0, 0, ncomp, 0);
+    }
+}
+
+} // namespace
+
 //
 // Fill valid and ghost data in the MultiFab "mf"
 // This version fills the MultiFab mf in valid regions with the "state data" at the given time;
@@ -19,7 +47,62 @@ ERF::FillPatch (int lev, Real time, const Vector<MultiFab*>& mfs)
     int bccomp;
     amrex::Interpolater* mapper = nullptr;
 
+    // With erf.use_fill_tracking a fill of the state data itself is skipped when it would repeat
+    //    the last one: nothing it reads from has changed since, and neither has the time.
+    //    The bcs may also depend on the terrain or on the boundary planes read in between,
+    //    so we don't do this with moving terrain or with boundary plane input.
+    bool track_fill = solverChoice.use_fill_tracking && solverChoice.terrain_type != 1 && !m_r2d;
+#ifdef ERF_USE_MULTIBLOCK
+    // The multiblock driver writes into vars_new behind our back
+    track_fill = false;
+#endif
+    for (int var_idx = 0; var_idx < Vars::NumTypes; ++var_idx) {
+        track_fill = track_fill && (mfs[var_idx] == &vars_new[lev][var_idx] ||
+                                    mfs[var_idx] == &vars_old[lev][var_idx]);
+    }
+
+    Vector<const MultiFab*> fill_srcs;
+    Vector<Real>            fill_times = {time};
+    if (track_fill)
+    {
+        if (lev > 0) {
+            for (int var_idx = 0; var_idx < Vars::NumTypes; ++var_idx) {
+                fill_srcs.push_back(&vars_old[lev-1][var_idx]);
+                fill_srcs.push_back(&vars_new[lev-1][var_idx]);
+            }
+            fill_times.push_back(t_old[lev-1]);
+            fill_times.push_back(t_new[lev-1]);
+        }
+
+        const bool skip = fill_tracker.is_current(mfs, fill_srcs, fill_times);
+        fill_tracker.count_fill(skip);
+        if (skip) return;
+    }
+
+    // At level 0 with erf.use_aggregated_fill the ghost cells of all four MultiFabs are
+    //    exchanged together (unless they are on other grids, e.g. in RemakeLevel)
+    bool aggregated_fill = (lev == 0 && solverChoice.use_aggregated_fill && ghost_exchange[lev]);
     for (int var_idx = 0; var_idx < Vars::NumTypes; ++var_idx) {
+        aggregated_fill = aggregated_fill &&
+            mfs[var_idx]->boxArray()        == vars_new[lev][var_idx].boxArray() &&
+            mfs[var_idx]->DistributionMap() == vars_new[lev][var_idx].DistributionMap();
+    }
+
+    if (aggregated_fill)
+    {
+        Vector<int>     scomp(Vars::NumTypes, 0);
+        Vector<int>     ncomp(Vars::NumTypes);
+        Vector<IntVect> nghost(Vars::NumTypes);
+        for (int var_idx = 0; var_idx < Vars::NumTypes; ++var_idx) {
+            fill_valid_at_time(*mfs[var_idx], vars_old[lev][var_idx], vars_new[lev][var_idx],
+                               t_old[lev], t_new[lev], time);
+            ncomp[var_idx]  = mfs[var_idx]->nComp();
+            nghost[var_idx] = mfs[var_idx]->nGrowVect();
+        }
+        ghost_exchange[lev]->FillBoundary(mfs, scomp, ncomp, nghost, geom[lev].periodicity());
+    }
+
+    for (int var_idx = 0; var_idx < Vars::NumTypes && !aggregated_fill; ++var_idx) {
         MultiFab& mf = *mfs[var_idx];
         const int icomp = 0;
         const int ncomp = mf.nComp();
@@ -84,6 +167,8 @@ ERF::FillPatch (int lev, Real time, const Vector<MultiFab*>& mfs)
 #ifdef ERF_USE_NETCDF
     if (init_type == "real") fill_from_wrfbdy(mfs,time);
 #endif
+
+    if (track_fill) fill_tracker.record(mfs, fill_srcs, fill_times);
 }
 
 //
@@ -107,6 +192,21 @@ ERF::FillIntermediatePatch (int lev, Real time,
     // We should always pass cons, xvel, yvel, and zvel (in that order) in the mfs vector
     AMREX_ALWAYS_ASSERT(mfs.size() == Vars::NumTypes);
 
+    if (lev == 0 && solverChoice.use_aggregated_fill)
+    {
+        FillIntermediatePatchStart(lev, mfs, ng_cons, ng_vel, cons_only, icomp_cons, ncomp_cons);
+        FillIntermediatePatchFinish(lev, time, mfs, ng_cons, ng_vel, cons_only, icomp_cons, ncomp_cons,
+                                    eddyDiffs, allow_most_bcs);
+        return;
+    }
+
+    // The coarse data only changes when the fill tracker versions or the times of the coarse level do
+    bool use_fill_patcher = (lev > 0 && solverChoice.use_fill_patcher);
+#ifdef ERF_USE_MULTIBLOCK
+    // The multiblock driver writes into vars_new behind our back
+    use_fill_patcher = false;
+#endif
+
     for (int var_idx = 0; var_idx < Vars::NumTypes; ++var_idx)
     {
         if (cons_only && var_idx != Vars::cons) continue;
@@ -152,6 +252,16 @@ ERF::FillIntermediatePatch (int lev, Real time,
         {
             mf.FillBoundary(icomp,ncomp,ngvect,geom[lev].periodicity());
         }
+        else if (use_fill_patcher)
+        {
+            const MultiFab* crse_old = &vars_old[lev-1][var_idx];
+            const MultiFab* crse_new = &vars_new[lev-1][var_idx];
+
+            ERFFillPatcher& fp = *fill_patcher[lev][var_idx];
+            fp.registerCoarseData({crse_old, crse_new}, {t_old[lev-1], t_new[lev-1]},
+                                  {fill_tracker.version(crse_old), fill_tracker.version(crse_new)});
+            fp.fillCoarseFineBoundary(mf, time, icomp, ncomp, domain_bcs_type, bccomp);
+        }
         else
         {
             Vector<MultiFab*> fmf = {&mf};
@@ -165,6 +275,22 @@ ERF::FillIntermediatePatch (int lev, Real time,
         }
     }
 
+    FillIntermediatePatchBCs(lev, time, mfs, ng_cons, ng_vel, cons_only, icomp_cons, ncomp_cons,
+                             eddyDiffs, allow_most_bcs);
+}
+
+//
+// Impose the physical, boundary-plane, wrfbdy and MOST bcs on the MultiFabs in "mfs"
+//    once their ghost cells have been filled from other grids at the same level
+//
+void
+ERF::FillIntermediatePatchBCs (int lev, Real time,
+                               const Vector<MultiFab*>& mfs,
+                               int ng_cons, int ng_vel, bool cons_only,
+                               int icomp_cons, int ncomp_cons,
+                               MultiFab* eddyDiffs,
+                               bool allow_most_bcs)
+{
     // ***************************************************************************
     // Physical bc's at domain boundary
     // ***************************************************************************
@@ -187,6 +313,78 @@ ERF::FillIntermediatePatch (int lev, Real time,
         m_most->impose_most_bcs(lev,mfs,eddyDiffs);
 }
 
+//
+// Split-phase version of FillIntermediatePatch at level 0: FillIntermediatePatchStart posts
+//    the ghost cell exchange for "mfs" and returns immediately; FillIntermediatePatchFinish
+//    waits for it and then imposes the bcs. The valid data in "mfs" may be read, and any
+//    other MultiFab written, in between. Together they fill exactly what
+//    FillIntermediatePatch fills with the same arguments.
+//
+void
+ERF::FillIntermediatePatchStart (int lev,
+                                 const Vector<MultiFab*>& mfs,
+                                 int ng_cons, int ng_vel, bool cons_only,
+                                 int icomp_cons, int ncomp_cons)
+{
+    BL_PROFILE("FillIntermediatePatchStart()");
+    AMREX_ALWAYS_ASSERT(lev == 0);
+    AMREX_ALWAYS_ASSERT(mfs.size() == Vars::NumTypes);
+
+    if (solverChoice.use_aggregated_fill)
+    {
+        int nmf = cons_only ? 1 : Vars::NumTypes;
+        Vector<MultiFab*> fill_mfs(mfs.begin(), mfs.begin() + nmf);
+        Vector<int>       scomp  = {icomp_cons, 0, 0, 0};
+        Vector<int>       ncomp  = {ncomp_cons, 1, 1, 1};
+        Vector<IntVect>   nghost = {IntVect(ng_cons,ng_cons,ng_cons), IntVect(ng_vel,ng_vel,ng_vel),
+                                    IntVect(ng_vel,ng_vel,ng_vel)   , IntVect(ng_vel,ng_vel,0)};
+        scomp.resize(nmf);
+        ncomp.resize(nmf);
+        nghost.resize(nmf);
+        ghost_exchange[lev]->FillBoundary_nowait(fill_mfs, scomp, ncomp, nghost, geom[lev].periodicity());
+        return;
+    }
+
+    for (int var_idx = 0; var_idx < Vars::NumTypes; ++var_idx)
+    {
+        if (cons_only && var_idx != Vars::cons) continue;
+
+        if (var_idx == Vars::cons) {
+            mfs[var_idx]->FillBoundary_nowait(icomp_cons,ncomp_cons,IntVect(ng_cons,ng_cons,ng_cons),
+                                              geom[lev].periodicity());
+        } else if (var_idx == Vars::zvel) {
+            mfs[var_idx]->FillBoundary_nowait(0,1,IntVect(ng_vel,ng_vel,0),geom[lev].periodicity());
+        } else {
+            mfs[var_idx]->FillBoundary_nowait(0,1,IntVect(ng_vel,ng_vel,ng_vel),geom[lev].periodicity());
+        }
+    }
+}
+
+void
+ERF::FillIntermediatePatchFinish (int lev, Real time,
+                                  const Vector<MultiFab*>& mfs,
+                                  int ng_cons, int ng_vel, bool cons_only,
+                                  int icomp_cons, int ncomp_cons,
+                                  MultiFab* eddyDiffs,
+                                  bool allow_most_bcs)
+{
+    BL_PROFILE("FillIntermediatePatchFinish()");
+    AMREX_ALWAYS_ASSERT(lev == 0);
+
+    if (solverChoice.use_aggregated_fill) {
+        ghost_exchange[lev]->FillBoundary_finish();
+    } else {
+        for (int var_idx = 0; var_idx < Vars::NumTypes; ++var_idx)
+        {
+            if (cons_only && var_idx != Vars::cons) continue;
+            mfs[var_idx]->FillBoundary_finish();
+        }
+    }
+
+    FillIntermediatePatchBCs(lev, time, mfs, ng_cons, ng_vel, cons_only, icomp_cons, ncomp_cons,
+                             eddyDiffs, allow_most_bcs);
+}
+
 // Fill an entire multifab by interpolating from the coarser level -- this is used
 //     only when a new level of refinement is being created during a run (i.e not at initialization)
 //     This will never be used with static refinement.
@@ -2,53 +2,171 @@
 
 using namespace amrex;
 
-ERFFillPatcher::ERFFillPatcher (BoxArray const& fba, DistributionMapping const& fdm,
-                                Geometry const& fgeom,
-                                BoxArray const& cba, DistributionMapping const& cdm,
-                                Geometry const& cgeom,
-                                int nghost, int ncomp, InterpBase* interp)
-    : m_fba(fba),
-      m_cba(cba),
-      m_fdm(fdm),
-      m_cdm(cdm),
-      m_fgeom(fgeom),
+ERFFillPatcher::ERFFillPatcher (Geometry const& fgeom, Geometry const& cgeom,
+                                IntVect const& ratio, Interpolater* interp)
+    : m_fgeom(fgeom),
       m_cgeom(cgeom),
-      m_nghost(nghost),
-      m_ncomp(ncomp),
+      m_ratio(ratio),
       m_interp(interp)
+{}
+
+void ERFFillPatcher::registerCoarseData (Vector<MultiFab const*> const& crse_data,
+                                         Vector<Real> const& crse_time,
+                                         Vector<Long> const& crse_version)
+{
+    AMREX_ALWAYS_ASSERT(crse_data.size() == 2);
+    AMREX_ALWAYS_ASSERT(crse_time.size() == 2 && crse_version.size() == 2);
+
+    if (crse_data == m_crse_src && crse_time == m_crse_time && crse_version == m_crse_version) return;
+
+    m_crse_src     = crse_data;
+    m_crse_time    = crse_time;
+    m_crse_version = crse_version;
+    m_fine_patch.clear();
+}
+
+ERFFillPatcher::FinePatch&
+ERFFillPatcher::fine_patch (MultiFab const& mf, int scomp, int ncomp,
+                            Vector<BCRec> const& bcs, int bcscomp)
 {
-    AMREX_ALWAYS_ASSERT(nghost < 0);
-    Box const fine_valid_box = amrex::grow(fba.minimalBox(), IntVect(nghost,nghost,0));
+    const IntVect& nghost  = mf.nGrowVect();
+    const IndexType ixtype = mf.ixType();
 
-    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
-        m_ratio[idim] = m_fgeom.Domain().length(idim) / m_cgeom.Domain().length(idim);
+    for (auto& p : m_fine_patch) {
+        if (p->bdkey == mf.getBDKey() && p->ixtype == ixtype && p->nghost == nghost &&
+            p->scomp == scomp && p->ncomp == ncomp) return *p;
     }
 
-    BoxList bl;
-    const int nfboxes = fba.size();
-    for (int ibox = 0; ibox < nfboxes; ++ibox) {
-        Box vbx = fba[ibox];
-        BoxList const& bndry = amrex::boxDiff(vbx, fine_valid_box);
-        if (bndry.isNotEmpty()) {
-            bl.join(bndry);
+    auto p = std::make_unique<FinePatch>();
+    p->bdkey  = mf.getBDKey();
+    p->ixtype = ixtype;
+    p->nghost = nghost;
+    p->scomp  = scomp;
+    p->ncomp  = ncomp;
+
+    // The ghost region of every fine box, in pieces owned by the rank that owns the box
+    const BoxArray& ba = mf.boxArray();
+    const DistributionMapping& dm = mf.DistributionMap();
+    BoxList bl_shell(ixtype);
+    Vector<int> pmap_shell;
+    for (int i = 0; i < ba.size(); ++i) {
+        const Box& vbx = ba[i];
+        for (const Box& b : amrex::boxDiff(amrex::grow(vbx,nghost), vbx)) {
+            bl_shell.push_back(b);
+            p->parent.push_back(i);
+            pmap_shell.push_back(dm[i]);
         }
     }
 
-    BoxList cbl;
-    cbl.reserve(bl.size());
-    for (auto const& b : bl) {
-        cbl.push_back(interp->CoarseBox(b, m_ratio));
+    if (!bl_shell.isEmpty())
+    {
+        BoxArray ba_shell(std::move(bl_shell));
+        DistributionMapping dm_shell(std::move(pmap_shell));
+        for (int n = 0; n < 2; ++n) {
+            p->fine_data[n].define(ba_shell, dm_shell, ncomp, 0);
+        }
+        p->mask.define(ba_shell, dm_shell, 1, 0);
+        p->mask.setVal(0);
+
+        const InterpolaterBoxCoarsener& coarsener = m_interp->BoxCoarsener(m_ratio);
+
+        // As in FillPatchTwoLevels, the coarse boxes of face-centered data are those of the
+        //    cell-centered data, and it is interpolated on the refined coarse boxes
+        const bool face_data = (ixtype.nodeCentered(0) + ixtype.nodeCentered(1) + ixtype.nodeCentered(2) == 1);
+
+        MultiFab mf_cc(amrex::convert(ba, IntVect(0)), dm, ncomp, nghost, MFInfo().SetAlloc(false));
+        const FabArrayBase::FPinfo& fpc = FabArrayBase::TheFPinfo(face_data ? mf_cc : mf,
+                                                                  face_data ? mf_cc : mf,
+                                                                  nghost, coarsener, m_fgeom, m_cgeom, nullptr);
+
+        if (!fpc.ba_crse_patch.empty())
+        {
+            const Box dest_domain = amrex::grow(amrex::convert(m_fgeom.Domain(), ixtype), nghost);
+
+            for (int n = 0; n < 2; ++n)
+            {
+                // The same copy as in FillPatchSingleLevel at the time of this state
+                MultiFab mf_crse_patch = make_mf_crse_patch<MultiFab>(fpc, ncomp, ixtype);
+                mf_set_domain_bndry(mf_crse_patch, m_cgeom);
+                mf_crse_patch.ParallelCopy(*m_crse_src[n], scomp, 0, ncomp, IntVect(0), IntVect(0),
+                                           m_cgeom.periodicity());
+
+                // face_linear_interp sets every face of the refined patch, so unlike
+                //    FillPatchTwoLevels we do not start from the fine data there
+                MultiFab mf_patch = face_data ? make_mf_refined_patch<MultiFab>(fpc, ncomp, ixtype, m_ratio)
+                                              : make_mf_fine_patch<MultiFab>(fpc, ncomp);
+
+                FillPatchInterp(mf_patch, 0, mf_crse_patch, 0, ncomp, IntVect(0),
+                                m_cgeom, m_fgeom, dest_domain, m_ratio, m_interp, bcs, bcscomp);
+
+                // The cells FillPatchTwoLevels copies to the ghost region of the fine boxes
+                p->fine_data[n].ParallelCopy(mf_patch, 0, 0, ncomp);
+
+                if (n == 0) {
+                    iMultiFab mask_patch(mf_patch.boxArray(), mf_patch.DistributionMap(), 1, 0);
+                    mask_patch.setVal(1);
+                    p->mask.ParallelCopy(mask_patch, 0, 0, 1);
+                }
+            }
+        }
     }
 
-    BoxArray cf_fba(std::move(bl));
-    DistributionMapping cf_dm(cf_fba);
-    m_cf_fine_data.define(cf_fba, cf_dm, m_ncomp, 0);
-    m_cf_crse_data.emplace_back(BoxArray(std::move(cbl)), cf_dm, m_ncomp, 0);
+    m_fine_patch.push_back(std::move(p));
+    return *m_fine_patch.back();
 }
 
-void ERFFillPatcher::registerCoarseData (Vector<MultiFab const*> const& crse_data,
-                                         Vector<amrex::Real> const& /*crse_time*/)
+void ERFFillPatcher::fillCoarseFineBoundary (MultiFab& mf, Real time, int scomp, int ncomp,
+                                             Vector<BCRec> const& bcs, int bcscomp)
 {
-    AMREX_ALWAYS_ASSERT(crse_data.size() == 1);
-    m_cf_crse_data[0].ParallelCopy(*crse_data[0], m_cgeom.periodicity());
+    BL_PROFILE("ERFFillPatcher::fillCoarseFineBoundary()");
+    AMREX_ALWAYS_ASSERT(m_crse_src.size() == 2);
+
+    const IntVect& nghost = mf.nGrowVect();
+    if (nghost.max() > 0)
+    {
+        FinePatch& fp = fine_patch(mf, scomp, ncomp, bcs, bcscomp);
+
+        if (fp.mask.ok())
+        {
+            const Real t0 = m_crse_time[0];
+            const Real t1 = m_crse_time[1];
+
+            // The same choice of weights as FillPatchSingleLevel
+            Real alpha, beta;
+            if (amrex::almostEqual(time,t0)) {
+                alpha = 1.0; beta = 0.0;
+            } else if (amrex::almostEqual(time,t1)) {
+                alpha = 0.0; beta = 1.0;
+            } else if (!amrex::almostEqual(t0,t1)) {
+                alpha = (t1-time)/(t1-t0);
+                beta  = (time-t0)/(t1-t0);
+            } else {
+                alpha = 1.0; beta = 0.0;
+            }
+
+            // Each piece of the ghost region only writes to its own fine box
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+            for (MFIter mfi(fp.mask); mfi.isValid(); ++mfi)
+            {
+                const Box& bx = mfi.validbox();
+
+                const Array4<Real>&       dst  = mf.array(fp.parent[mfi.index()]);
+                const Array4<const Real>& src0 = fp.fine_data[0].const_array(mfi);
+                const Array4<const Real>& src1 = fp.fine_data[1].const_array(mfi);
+                const Array4<const int>&  msk  = fp.mask.const_array(mfi);
+
+                ParallelFor(bx, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+                {
+                    if (msk(i,j,k)) {
+                        dst(i,j,k,scomp+n) = alpha*src0(i,j,k,n) + beta*src1(i,j,k,n);
+                    }
+                });
+            }
+        }
+    }
+
+    // The ghost cells covered by the fine grids
+    mf.FillBoundary(scomp, ncomp, nghost, m_fgeom.periodicity());
 }
@@ -0,0 +1,81 @@
+#include <AMReX_Print.H>
+#include <ERF_FillTracker.H>
+
+using namespace amrex;
+
+void
+ERFFillTracker::touch (const MultiFab& mf)
+{
+    m_version[&mf] = ++m_last_version;
+}
+
+void
+ERFFillTracker::touch (const Vector<MultiFab>& mfs)
+{
+    for (const auto& mf : mfs) {
+        touch(mf);
+    }
+}
+
+Long
+ERFFillTracker::version (const MultiFab* mf) const
+{
+    auto it = m_version.find(mf);
+    return (it == m_version.end()) ? 0 : it->second;
+}
+
+Vector<Long>
+ERFFillTracker::versions (const Vector<MultiFab*>& mfs, const Vector<const MultiFab*>& srcs) const
+{
+    Vector<Long> v;
+    for (const auto* mf : mfs)  { v.push_back(version(mf)); }
+    for (const auto* mf : srcs) { v.push_back(version(mf)); }
+    return v;
+}
+
+const ERFFillTracker::Fill*
+ERFFillTracker::find (const Vector<MultiFab*>& mfs) const
+{
+    for (const auto& f : m_fills) {
+        if (f.mfs.size() != mfs.size()) continue;
+        bool same = true;
+        for (int n = 0; n < static_cast<int>(mfs.size()); ++n) {
+            same = same && (f.mfs[n] == mfs[n]);
+        }
+        if (same) return &f;
+    }
+    return nullptr;
+}
+
+bool
+ERFFillTracker::is_current (const Vector<MultiFab*>& mfs, const Vector<const MultiFab*>& srcs,
+                            const Vector<Real>& times) const
+{
+    const Fill* f = find(mfs);
+    return f != nullptr && f->srcs == srcs && f->times == times && f->versions == versions(mfs, srcs);
+}
+
+void
+ERFFillTracker::record (const Vector<MultiFab*>& mfs, const Vector<const MultiFab*>& srcs,
+                        const Vector<Real>& times)
+{
+    Fill f;
+    f.mfs.assign(mfs.begin(), mfs.end());
+    f.srcs     = srcs;
+    f.versions = versions(mfs, srcs);
+    f.times    = times;
+
+    const Fill* old = find(mfs);
+    if (old != nullptr) {
+        m_fills[old - m_fills.data()] = f;
+    } else {
+        m_fills.push_back(f);
+    }
+}
+
+void
+ERFFillTracker::print_step_stats () const
+{
+    amrex::Print() << "FillPatch of the state data: " << m_step_skipped << " of " << m_step_fills
+                   << " fills skipped this step" << std::endl;
+}
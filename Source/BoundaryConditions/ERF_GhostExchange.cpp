@@ -0,0 +1,346 @@
+#include <limits>
+#include <map>
+
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Print.H>
+#include <ERF_GhostExchange.H>
+
+using namespace amrex;
+
+/**
+ * Everything needed to exchange the ghost cells of one set of MultiFabs: the copies between
+ * grids on this rank, and for every other rank we talk to a single message in each direction
+ * made of the pieces of all the MultiFabs, one after another. The pieces are taken from the
+ * FillBoundary metadata of each MultiFab, whose send and receive tags come in matching order.
+ */
+struct ERFGhostExchange::Plan
+{
+    //! A box of one MultiFab packed into (or unpacked from) a message
+    struct Tag {
+        int  mf;      //!< index of the MultiFab in the exchange
+        int  fab;     //!< global index of the grid
+        Box  box;     //!< cells sent (from the valid region) or received (into the ghost region)
+        Long offset;  //!< start in the buffer, in Reals
+    };
+
+    //! A copy between two grids on this rank
+    struct LocalTag {
+        int mf;
+        int src;
+        int dst;
+        Box sbox;
+        Box dbox;
+    };
+
+    Vector<BoxArray>            ba;
+    Vector<DistributionMapping> dm;
+    Vector<int>                 ncomp;
+    Vector<IntVect>             nghost;
+    Periodicity                 period;
+
+    Vector<LocalTag> local;
+
+    Vector<int>  snd_rank, rcv_rank;
+    Vector<Long> snd_offset, rcv_offset; //!< start of each message, in Reals
+    Vector<Long> snd_size, rcv_size;     //!< length of each message, in Reals
+    Vector<Tag>  snd_tags, rcv_tags;
+    Long         snd_total = 0;
+    Long         rcv_total = 0;
+
+    //! Number of messages this rank would send with a separate FillBoundary per MultiFab
+    Long num_separate = 0;
+
+    Real* snd_buf = nullptr;
+    Real* rcv_buf = nullptr;
+
+#ifdef BL_USE_MPI
+    Vector<MPI_Request> snd_req, rcv_req;
+#endif
+
+    bool matches (const Vector<MultiFab*>& mfs, const Vector<int>& a_ncomp,
+                  const Vector<IntVect>& a_nghost, const Periodicity& a_period) const
+    {
+        if (static_cast<int>(mfs.size()) != static_cast<int>(ba.size()) || !(period == a_period)) {
+            return false;
+        }
+        for (int n = 0; n < static_cast<int>(mfs.size()); ++n) {
+            if (ncomp[n] != a_ncomp[n] || nghost[n] != a_nghost[n] ||
+                !(mfs[n]->boxArray() == ba[n]) || !(mfs[n]->DistributionMap() == dm[n])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    ~Plan ()
+    {
+#ifdef BL_USE_MPI
+        for (auto& r : snd_req) { MPI_Request_free(&r); }
+        for (auto& r : rcv_req) { MPI_Request_free(&r); }
+#endif
+        if (snd_buf) The_Pinned_Arena()->free(snd_buf);
+        if (rcv_buf) The_Pinned_Arena()->free(rcv_buf);
+    }
+};
+
+ERFGhostExchange::~ERFGhostExchange ()
+{
+    clear();
+#ifdef BL_USE_MPI
+    if (m_comm != MPI_COMM_NULL) {
+        MPI_Comm_free(&m_comm);
+    }
+#endif
+}
+
+ERFGhostExchange::Plan&
+ERFGhostExchange::get_plan (const Vector<MultiFab*>& mfs, const Vector<int>& ncomp,
+                            const Vector<IntVect>& nghost, const Periodicity& period)
+{
+    for (auto& p : m_plans) {
+        if (p->matches(mfs, ncomp, nghost, period)) {
+            return *p;
+        }
+    }
+
+    BL_PROFILE("ERFGhostExchange::build_plan()");
+
+    auto p = std::make_unique<Plan>();
+    p->period = period;
+
+    std::map<int, Vector<Plan::Tag> > snd_map;
+    std::map<int, Vector<Plan::Tag> > rcv_map;
+
+    for (int n = 0; n < static_cast<int>(mfs.size()); ++n)
+    {
+        const MultiFab& mf = *mfs[n];
+        p->ba.push_back(mf.boxArray());
+        p->dm.push_back(mf.DistributionMap());
+        p->ncomp.push_back(ncomp[n]);
+        p->nghost.push_back(nghost[n]);
+
+        const FabArrayBase::FB& fb = mf.getFB(nghost[n], period);
+
+        for (const auto& tag : *fb.m_LocTags) {
+            p->local.push_back({n, tag.srcIndex, tag.dstIndex, tag.sbox, tag.dbox});
+        }
+        p->num_separate += static_cast<Long>(fb.m_SndTags->size());
+        for (const auto& kv : *fb.m_SndTags) {
+            for (const auto& tag : kv.second) {
+                snd_map[kv.first].push_back({n, tag.srcIndex, tag.sbox, 0});
+            }
+        }
+        for (const auto& kv : *fb.m_RcvTags) {
+            for (const auto& tag : kv.second) {
+                rcv_map[kv.first].push_back({n, tag.dstIndex, tag.dbox, 0});
+            }
+        }
+    }
+
+    // Lay the messages out one after another, each holding its pieces in the order above
+    auto layout = [&] (std::map<int, Vector<Plan::Tag> >& msg_map,
+                       Vector<int>& rank, Vector<Long>& offset, Vector<Long>& size,
+                       Vector<Plan::Tag>& tags, Long& total)
+    {
+        total = 0;
+        for (auto& kv : msg_map) {
+            rank.push_back(kv.first);
+            offset.push_back(total);
+            Long start = total;
+            for (auto& tag : kv.second) {
+                tag.offset = total;
+                total += tag.box.numPts() * ncomp[tag.mf];
+                tags.push_back(tag);
+            }
+            size.push_back(total - start);
+        }
+    };
+    layout(snd_map, p->snd_rank, p->snd_offset, p->snd_size, p->snd_tags, p->snd_total);
+    layout(rcv_map, p->rcv_rank, p->rcv_offset, p->rcv_size, p->rcv_tags, p->rcv_total);
+
+    if (p->snd_total > 0) {
+        p->snd_buf = static_cast<Real*>(The_Pinned_Arena()->alloc(p->snd_total*sizeof(Real)));
+    }
+    if (p->rcv_total > 0) {
+        p->rcv_buf = static_cast<Real*>(The_Pinned_Arena()->alloc(p->rcv_total*sizeof(Real)));
+    }
+
+#ifdef BL_USE_MPI
+    if (m_comm == MPI_COMM_NULL) {
+        MPI_Comm_dup(ParallelDescriptor::Communicator(), &m_comm);
+    }
+
+    // Plans are built in the same order on every rank, so the index is a safe tag
+    const int mpi_tag = static_cast<int>(m_plans.size());
+    const MPI_Datatype mpi_type = ParallelDescriptor::Mpi_typemap<Real>::type();
+
+    p->rcv_req.resize(p->rcv_rank.size());
+    for (int m = 0; m < static_cast<int>(p->rcv_rank.size()); ++m) {
+        AMREX_ALWAYS_ASSERT(p->rcv_size[m] <= std::numeric_limits<int>::max());
+        MPI_Recv_init(p->rcv_buf + p->rcv_offset[m], static_cast<int>(p->rcv_size[m]), mpi_type,
+                      p->rcv_rank[m], mpi_tag, m_comm, &p->rcv_req[m]);
+    }
+    p->snd_req.resize(p->snd_rank.size());
+    for (int m = 0; m < static_cast<int>(p->snd_rank.size()); ++m) {
+        AMREX_ALWAYS_ASSERT(p->snd_size[m] <= std::numeric_limits<int>::max());
+        MPI_Send_init(p->snd_buf + p->snd_offset[m], static_cast<int>(p->snd_size[m]), mpi_type,
+                      p->snd_rank[m], mpi_tag, m_comm, &p->snd_req[m]);
+    }
+#endif
+
+    m_plans.push_back(std::move(p));
+    return *m_plans.back();
+}
+
+void
+ERFGhostExchange::FillBoundary_nowait (const Vector<MultiFab*>& mfs,
+                                       const Vector<int>& scomp, const Vector<int>& ncomp,
+                                       const Vector<IntVect>& nghost,
+                                       const Periodicity& period)
+{
+    BL_PROFILE("ERFGhostExchange::FillBoundary_nowait()");
+    AMREX_ALWAYS_ASSERT(m_active == nullptr);
+    AMREX_ALWAYS_ASSERT(mfs.size() == scomp.size() && mfs.size() == ncomp.size() &&
+                        mfs.size() == nghost.size());
+
+    Real t0 = amrex::second();
+
+    Plan& p = get_plan(mfs, ncomp, nghost, period);
+
+#ifdef BL_USE_MPI
+    if (!p.rcv_req.empty()) {
+        MPI_Startall(static_cast<int>(p.rcv_req.size()), p.rcv_req.data());
+    }
+
+    for (const auto& tag : p.snd_tags)
+    {
+        const Array4<const Real>& src = mfs[tag.mf]->const_array(tag.fab);
+        const int sc  = scomp[tag.mf];
+        const int nc  = ncomp[tag.mf];
+        const auto lo = lbound(tag.box);
+        const auto len = length(tag.box);
+        Real* buf = p.snd_buf + tag.offset;
+        ParallelFor(tag.box, nc, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+        {
+            buf[((n*len.z + (k-lo.z))*len.y + (j-lo.y))*len.x + (i-lo.x)] = src(i,j,k,sc+n);
+        });
+    }
+    Gpu::streamSynchronize();
+
+    if (!p.snd_req.empty()) {
+        MPI_Startall(static_cast<int>(p.snd_req.size()), p.snd_req.data());
+    }
+#endif
+
+    for (const auto& tag : p.local)
+    {
+        const Array4<const Real>& src = mfs[tag.mf]->const_array(tag.src);
+        const Array4<      Real>& dst = mfs[tag.mf]->array(tag.dst);
+        const int sc = scomp[tag.mf];
+        const int nc = ncomp[tag.mf];
+        const IntVect shift = tag.sbox.smallEnd() - tag.dbox.smallEnd();
+        ParallelFor(tag.dbox, nc, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+        {
+            dst(i,j,k,sc+n) = src(i+shift[0],j+shift[1],k+shift[2],sc+n);
+        });
+    }
+
+    m_active       = &p;
+    m_active_mfs   = mfs;
+    m_active_scomp = scomp;
+
+    ++m_step_fills;
+    m_step_msgs          += static_cast<Long>(p.snd_rank.size());
+    m_step_msgs_separate += p.num_separate;
+    m_step_bytes         += p.snd_total * static_cast<Long>(sizeof(Real));
+    m_step_time          += amrex::second() - t0;
+}
+
+void
+ERFGhostExchange::FillBoundary_finish ()
+{
+    BL_PROFILE("ERFGhostExchange::FillBoundary_finish()");
+    AMREX_ALWAYS_ASSERT(m_active != nullptr);
+
+    Real t0 = amrex::second();
+
+    Plan& p = *m_active;
+
+#ifdef BL_USE_MPI
+    if (!p.rcv_req.empty()) {
+        MPI_Waitall(static_cast<int>(p.rcv_req.size()), p.rcv_req.data(), MPI_STATUSES_IGNORE);
+    }
+
+    for (const auto& tag : p.rcv_tags)
+    {
+        const Array4<Real>& dst = m_active_mfs[tag.mf]->array(tag.fab);
+        const int sc  = m_active_scomp[tag.mf];
+        const int nc  = p.ncomp[tag.mf];
+        const auto lo = lbound(tag.box);
+        const auto len = length(tag.box);
+        const Real* buf = p.rcv_buf + tag.offset;
+        ParallelFor(tag.box, nc, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+        {
+            dst(i,j,k,sc+n) = buf[((n*len.z + (k-lo.z))*len.y + (j-lo.y))*len.x + (i-lo.x)];
+        });
+    }
+
+    if (!p.snd_req.empty()) {
+        MPI_Waitall(static_cast<int>(p.snd_req.size()), p.snd_req.data(), MPI_STATUSES_IGNORE);
+    }
+#endif
+
+    // The buffers are reused by the next exchange
+    Gpu::streamSynchronize();
+
+    m_active = nullptr;
+    m_active_mfs.clear();
+    m_active_scomp.clear();
+
+    m_step_time += amrex::second() - t0;
+}
+
+void
+ERFGhostExchange::FillBoundary (const Vector<MultiFab*>& mfs,
+                                const Vector<int>& scomp, const Vector<int>& ncomp,
+                                const Vector<IntVect>& nghost,
+                                const Periodicity& period)
+{
+    FillBoundary_nowait(mfs, scomp, ncomp, nghost, period);
+    FillBoundary_finish();
+}
+
+void
+ERFGhostExchange::clear ()
+{
+    AMREX_ALWAYS_ASSERT(m_active == nullptr);
+    m_plans.clear();
+}
+
+void
+ERFGhostExchange::reset_step_stats ()
+{
+    m_step_fills         = 0;
+    m_step_msgs          = 0;
+    m_step_msgs_separate = 0;
+    m_step_bytes         = 0;
+    m_step_time          = 0.0;
+}
+
+void
+ERFGhostExchange::print_step_stats (int lev) const
+{
+    Long msgs     = m_step_msgs;
+    Long msgs_sep = m_step_msgs_separate;
+    Long bytes    = m_step_bytes;
+    Real time     = m_step_time;
+    ParallelDescriptor::ReduceLongSum(msgs);
+    ParallelDescriptor::ReduceLongSum(msgs_sep);
+    ParallelDescriptor::ReduceLongSum(bytes);
+    ParallelDescriptor::ReduceRealMax(time);
+
+    amrex::Print() << "Ghost exchange at level " << lev << ": "
+                   << m_step_fills << " fills this step sent " << msgs << " messages ("
+                   << msgs_sep << " with one exchange per MultiFab), " << bytes << " bytes; "
+                   << "max halo time " << time << " s" << std::endl;
+}
@@ -1,6 +1,7 @@
 #include "AMReX_PhysBCFunct.H"
 #include "IndexDefines.H"
 #include <ERF_PhysBCFunct.H>
+#include <AMReX_ParallelDescriptor.H>
 
 using namespace amrex;
 
@@ -24,31 +25,14 @@ void ERFPhysBCFunct::operator() (const Vector<MultiFab*>& mfs, int icomp_cons, i
 
     if (m_geom.isAllPeriodic()) return;
 
+    Real t0 = amrex::second();
+
     const auto& domain = m_geom.Domain();
     const auto dxInv   = m_geom.InvCellSizeArray();
 
-    // Create a grown domain box containing valid + periodic cells
-    Box gdomain  = domain;
-    for (int i = 0; i < AMREX_SPACEDIM; ++i) {
-        if (m_geom.isPeriodic(i)) {
-            gdomain.grow(i, nghost_cons[i]);
-        }
-    }
-
-    Box gdomainx = surroundingNodes(domain,0);
-    for (int i = 0; i < AMREX_SPACEDIM; ++i) {
-        if (m_geom.isPeriodic(i)) {
-            gdomainx.grow(i, nghost_vels[i]);
-        }
-    }
-
-    Box gdomainy = surroundingNodes(domain,1);
-    for (int i = 0; i < AMREX_SPACEDIM; ++i) {
-        if (m_geom.isPeriodic(i)) {
-            gdomainy.grow(i, nghost_vels[i]);
-        }
-    }
-
+    const WorkList& wl = get_work_list(*mfs[Vars::cons], nghost_cons, nghost_vels);
+    const BCRec* bcr   = wl.bcr.data();
+    const BCRec* bcr_d = wl.bcr_d.data();
 
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
@@ -81,33 +65,145 @@ void ERFPhysBCFunct::operator() (const Vector<MultiFab*>& mfs, int icomp_cons, i
                 z_nd_arr = m_z_phys_nd->const_array(mfi);
             }
 
+            const int li  = mfi.LocalIndex();
+            const int off = li * bcr_per_box;
+
             //! If there are cells not in the valid + periodic grown box
             //! we need to fill them here
-            if (!gdomain.contains(cbx))
+            if (wl.do_cons[li])
             {
                 int bccomp = BCVars::cons_bc;
                 impose_cons_bcs(cons_arr,cbx,domain,z_nd_arr,dxInv,
+                                bcr+off,bcr_d+off,
                                 icomp_cons,ncomp_cons,time,bccomp);
             }
 
-            if (!gdomainx.contains(xbx) && !cons_only)
+            if (wl.do_xvel[li] && !cons_only)
             {
                 impose_xvel_bcs(velx_arr,xbx,domain,z_nd_arr,dxInv,
+                                bcr+off+NVAR,bcr_d+off+NVAR,
                                 time,BCVars::xvel_bc);
             }
 
-            if (!gdomainy.contains(ybx) && !cons_only)
+            if (wl.do_yvel[li] && !cons_only)
             {
                 impose_yvel_bcs(vely_arr,ybx,domain,z_nd_arr,dxInv,
+                                bcr+off+NVAR+1,bcr_d+off+NVAR+1,
                                 time,BCVars::yvel_bc);
             }
 
             if (!cons_only) {
                 impose_zvel_bcs(velz_arr,zbx,domain,
                                 velx_arr,vely_arr,z_nd_arr,dxInv,
+                                bcr+off+NVAR+2,bcr_d+off+NVAR+2,
                                 time, BCVars::zvel_bc, m_terrain_type);
             }
 
         } // MFIter
     } // OpenMP
+
+    // One synchronization for all the grids rather than one per grid and variable
+    Gpu::streamSynchronize();
+
+    ++m_step_calls;
+    m_step_time += amrex::second() - t0;
 } // operator()
+
+//
+// Find, or build, the boundary work list for the grids of cons_mf with the given ghost cells
+//
+const ERFPhysBCFunct::WorkList&
+ERFPhysBCFunct::get_work_list (const MultiFab& cons_mf,
+                               IntVect const& nghost_cons, IntVect const& nghost_vels)
+{
+    for (const auto& wl : m_work_lists) {
+        if (wl->nghost_cons == nghost_cons && wl->nghost_vels == nghost_vels &&
+            wl->ba == cons_mf.boxArray() && wl->dm == cons_mf.DistributionMap()) {
+            return *wl;
+        }
+    }
+
+    BL_PROFILE("ERFPhysBCFunct::build_work_list()");
+
+    const auto& domain = m_geom.Domain();
+
+    // Create a grown domain box containing valid + periodic cells
+    Box gdomain  = domain;
+    for (int i = 0; i < AMREX_SPACEDIM; ++i) {
+        if (m_geom.isPeriodic(i)) {
+            gdomain.grow(i, nghost_cons[i]);
+        }
+    }
+
+    Box gdomainx = surroundingNodes(domain,0);
+    for (int i = 0; i < AMREX_SPACEDIM; ++i) {
+        if (m_geom.isPeriodic(i)) {
+            gdomainx.grow(i, nghost_vels[i]);
+        }
+    }
+
+    Box gdomainy = surroundingNodes(domain,1);
+    for (int i = 0; i < AMREX_SPACEDIM; ++i) {
+        if (m_geom.isPeriodic(i)) {
+            gdomainy.grow(i, nghost_vels[i]);
+        }
+    }
+
+    auto wl = std::make_unique<WorkList>();
+    wl->ba          = cons_mf.boxArray();
+    wl->dm          = cons_mf.DistributionMap();
+    wl->nghost_cons = nghost_cons;
+    wl->nghost_vels = nghost_vels;
+
+    const int nlocal = cons_mf.local_size();
+    wl->do_cons.resize(nlocal);
+    wl->do_xvel.resize(nlocal);
+    wl->do_yvel.resize(nlocal);
+    wl->bcr.resize(nlocal * bcr_per_box);
+
+    for (MFIter mfi(cons_mf); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.validbox();
+        Box cbx = bx;                     cbx.grow(nghost_cons);
+        Box xbx = surroundingNodes(bx,0); xbx.grow(nghost_vels);
+        Box ybx = surroundingNodes(bx,1); ybx.grow(nghost_vels);
+        Box zbx = surroundingNodes(bx,2); zbx.grow(0,nghost_vels[0]);
+                                          zbx.grow(1,nghost_vels[1]);
+
+        const int li = mfi.LocalIndex();
+        wl->do_cons[li] = !gdomain.contains(cbx);
+        wl->do_xvel[li] = !gdomainx.contains(xbx);
+        wl->do_yvel[li] = !gdomainy.contains(ybx);
+
+        // Based on BCRec for the domain, we need to make BCRec for each Box
+        Vector<BCRec> bcrs(NVAR);
+        amrex::setBC(cbx, domain, BCVars::cons_bc, 0, NVAR, m_domain_bcs_type, bcrs);
+        for (int n = 0; n < NVAR; ++n) {
+            wl->bcr[li*bcr_per_box + n] = bcrs[n];
+        }
+
+        Vector<BCRec> bcr_vel(1);
+        amrex::setBC(xbx, domain, BCVars::xvel_bc, 0, 1, m_domain_bcs_type, bcr_vel);
+        wl->bcr[li*bcr_per_box + NVAR  ] = bcr_vel[0];
+        amrex::setBC(ybx, domain, BCVars::yvel_bc, 0, 1, m_domain_bcs_type, bcr_vel);
+        wl->bcr[li*bcr_per_box + NVAR+1] = bcr_vel[0];
+        amrex::setBC(zbx, domain, BCVars::zvel_bc, 0, 1, m_domain_bcs_type, bcr_vel);
+        wl->bcr[li*bcr_per_box + NVAR+2] = bcr_vel[0];
+    }
+
+    wl->bcr_d.resize(wl->bcr.size());
+    Gpu::copy(Gpu::hostToDevice, wl->bcr.begin(), wl->bcr.end(), wl->bcr_d.begin());
+
+    m_work_lists.push_back(std::move(wl));
+    return *m_work_lists.back();
+}
+
+void
+ERFPhysBCFunct::print_step_stats () const
+{
+    Real time = m_step_time;
+    ParallelDescriptor::ReduceRealMax(time);
+
+    amrex::Print() << "Physical bcs at level " << m_lev << ": " << m_step_calls
+                   << " calls this step; max time " << time << " s" << std::endl;
+}
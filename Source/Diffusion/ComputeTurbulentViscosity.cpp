@@ -17,10 +17,13 @@ ComputeTurbulentViscosityPBL (const amrex::MultiFab& xvel,
                               bool /*vert_only*/);
 
 /** Compute Eddy Viscosity */
-void ComputeTurbulentViscosityLES (const amrex::MultiFab& Tau11, const amrex::MultiFab& Tau22, const amrex::MultiFab& Tau33,
-                                   const amrex::MultiFab& Tau12, const amrex::MultiFab& Tau13, const amrex::MultiFab& Tau23,
+void ComputeTurbulentViscosityLES (const amrex::MultiFab& xvel, const amrex::MultiFab& yvel, const amrex::MultiFab& zvel,
+                                   const amrex::MultiFab* Tau11, const amrex::MultiFab* Tau22, const amrex::MultiFab* Tau33,
+                                   const amrex::MultiFab* Tau12, const amrex::MultiFab* Tau13, const amrex::MultiFab* Tau23,
                                    const amrex::MultiFab& cons_in, amrex::MultiFab& eddyViscosity,
                                    const amrex::Geometry& geom,
+                                   const amrex::MultiFab* z_phys_nd, const amrex::BCRec* bc_ptr_h,
+                                   const amrex::MultiFab& mapfac_m,
                                    const amrex::MultiFab& mapfac_u, const amrex::MultiFab& mapfac_v,
                                    const SolverChoice& solverChoice)
 {
@@ -32,9 +35,16 @@ void ComputeTurbulentViscosityLES (const amrex::MultiFab& Tau11, const amrex::Mu
     {
       Real Cs = solverChoice.Cs;
 
+      // Without the level-wide strain (erf.use_tiled_stress) we make it here one tile at a time
+      const bool l_tiled_strain = (Tau11 == nullptr);
+      const bool l_use_terrain  = solverChoice.use_terrain;
+
 #ifdef _OPENMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
+      {
+      FArrayBox tau_fab;
+
       for (amrex::MFIter mfi(eddyViscosity,amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi)
       {
           Box bxcc  = mfi.tilebox();
@@ -42,16 +52,58 @@ void ComputeTurbulentViscosityLES (const amrex::MultiFab& Tau11, const amrex::Mu
         const Array4<Real>& mu_turb = eddyViscosity.array(mfi);
         const amrex::Array4<amrex::Real const > &cell_data = cons_in.array(mfi);
 
-        Array4<Real const> tau11 = Tau11.array(mfi);
-        Array4<Real const> tau22 = Tau22.array(mfi);
-        Array4<Real const> tau33 = Tau33.array(mfi);
-        Array4<Real const> tau12 = Tau12.array(mfi);
-        Array4<Real const> tau13 = Tau13.array(mfi);
-        Array4<Real const> tau23 = Tau23.array(mfi);
-
         Array4<Real const> mf_u = mapfac_u.array(mfi);
         Array4<Real const> mf_v = mapfac_v.array(mfi);
 
+        Array4<Real const> tau11, tau22, tau33;
+        Array4<Real const> tau12, tau13, tau23;
+        Elixir tau_eli;
+        if (l_tiled_strain) {
+            // These are the same boxes as the strain computed in TimeIntegration
+            Box gbx   = mfi.growntilebox(IntVect(1,1,0));
+            Box tbxxy = bxcc; tbxxy.convert(IntVect(1,1,0)); tbxxy.grow(IntVect(1,1,0));
+            Box tbxxz = bxcc; tbxxz.convert(IntVect(1,0,1)); tbxxz.grow(IntVect(1,1,0));
+            Box tbxyz = bxcc; tbxyz.convert(IntVect(0,1,1)); tbxyz.grow(IntVect(1,1,0));
+
+            Array4<Real> s11, s22, s33, s12, s13, s21, s23, s31, s32;
+            ResizeTileStress(gbx, l_use_terrain, tau_fab,
+                             s11, s22, s33, s12, s13, s21, s23, s31, s32);
+            tau_eli = tau_fab.elixir();
+
+            const Array4<const Real>& u = xvel.const_array(mfi);
+            const Array4<const Real>& v = yvel.const_array(mfi);
+            const Array4<const Real>& w = zvel.const_array(mfi);
+            const Array4<const Real>& mf_m = mapfac_m.const_array(mfi);
+
+            if (l_use_terrain) {
+                const Array4<const Real>& z_nd = z_phys_nd->const_array(mfi);
+                ComputeStrain_T(gbx, tbxxy, tbxxz, tbxyz,
+                                u, v, w,
+                                s11, s22, s33,
+                                s12, s13,
+                                s21, s23,
+                                s31, s32,
+                                z_nd, bc_ptr_h, dxInv,
+                                mf_m, mf_u, mf_v);
+            } else {
+                ComputeStrain_N(gbx, tbxxy, tbxxz, tbxyz,
+                                u, v, w,
+                                s11, s22, s33,
+                                s12, s13, s23,
+                                bc_ptr_h, dxInv,
+                                mf_m, mf_u, mf_v);
+            }
+            tau11 = s11; tau22 = s22; tau33 = s33;
+            tau12 = s12; tau13 = s13; tau23 = s23;
+        } else {
+            tau11 = Tau11->const_array(mfi);
+            tau22 = Tau22->const_array(mfi);
+            tau33 = Tau33->const_array(mfi);
+            tau12 = Tau12->const_array(mfi);
+            tau13 = Tau13->const_array(mfi);
+            tau23 = Tau23->const_array(mfi);
+        }
+
         ParallelFor(bxcc, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
         {
           Real s11bar = tau11(i,j,k);
@@ -73,7 +125,8 @@ void ComputeTurbulentViscosityLES (const amrex::MultiFab& Tau11, const amrex::Mu
           mu_turb(i, j, k, EddyDiff::Mom_h) = CsDeltaSqrMsf * cell_data(i, j, k, Rho_comp) * std::sqrt(2.0*SmnSmn);
           mu_turb(i, j, k, EddyDiff::Mom_v) = mu_turb(i, j, k, EddyDiff::Mom_h);
         });
-      }
+      } // mfi
+      } // omp
     }
     // DEARDORFF: Fill Kturb for momentum in horizontal and vertical
     //***********************************************************************************
@@ -268,12 +321,14 @@ void ComputeTurbulentViscosityLES (const amrex::MultiFab& Tau11, const amrex::Mu
    }
 }
 
-void ComputeTurbulentViscosity (const amrex::MultiFab& xvel , const amrex::MultiFab& yvel ,
-                                const amrex::MultiFab& Tau11, const amrex::MultiFab& Tau22, const amrex::MultiFab& Tau33,
-                                const amrex::MultiFab& Tau12, const amrex::MultiFab& Tau13, const amrex::MultiFab& Tau23,
+void ComputeTurbulentViscosity (const amrex::MultiFab& xvel , const amrex::MultiFab& yvel , const amrex::MultiFab& zvel ,
+                                const amrex::MultiFab* Tau11, const amrex::MultiFab* Tau22, const amrex::MultiFab* Tau33,
+                                const amrex::MultiFab* Tau12, const amrex::MultiFab* Tau13, const amrex::MultiFab* Tau23,
                                 const amrex::MultiFab& cons_in,
                                 amrex::MultiFab& eddyViscosity,
                                 const amrex::Geometry& geom,
+                                const amrex::MultiFab* z_phys_nd, const amrex::BCRec* bc_ptr_h,
+                                const amrex::MultiFab& mapfac_m,
                                 const amrex::MultiFab& mapfac_u, const amrex::MultiFab& mapfac_v,
                                 const SolverChoice& solverChoice,
                                 std::unique_ptr<ABLMost>& most,
@@ -305,10 +360,12 @@ void ComputeTurbulentViscosity (const amrex::MultiFab& xvel , const amrex::Multi
     }
 
     if (solverChoice.les_type != LESType::None) {
-        ComputeTurbulentViscosityLES(Tau11, Tau22, Tau33,
+        ComputeTurbulentViscosityLES(xvel, yvel, zvel,
+                                     Tau11, Tau22, Tau33,
                                      Tau12, Tau13, Tau23,
                                      cons_in, eddyViscosity,
-                                     geom, mapfac_u, mapfac_v,
+                                     geom, z_phys_nd, bc_ptr_h,
+                                     mapfac_m, mapfac_u, mapfac_v,
                                      solverChoice);
     }
 
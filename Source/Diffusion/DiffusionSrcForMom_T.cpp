@@ -1,6 +1,7 @@
 #include <AMReX.H>
 #include <DiffusionSrcForMom_T.H>
 #include <IndexDefines.H>
+#include <TerrainMetrics.H>
 
 using namespace amrex;
 
@@ -14,6 +15,8 @@ DiffusionSrcForMom_T (const Box& bxx, const Box& bxy , const Box& bxz,
                       const Array4<const Real>& tau21, const Array4<const Real>& tau23,
                       const Array4<const Real>& tau31, const Array4<const Real>& tau32,
                       const Array4<const Real>& cons , const Array4<const Real>& detJ ,
+                      const Array4<const Real>& met_x, const Array4<const Real>& met_y,
+                      const Array4<const Real>& met_z,
                       const SolverChoice& solverChoice,
                       const GpuArray<Real, AMREX_SPACEDIM>& dxInv,
                       const Array4<const Real>& mf_m,
@@ -34,7 +37,7 @@ DiffusionSrcForMom_T (const Box& bxx, const Box& bxy , const Box& bxz,
             Real diffContrib  = ( (tau11(i  , j  , k  ) - tau11(i-1, j  ,k  )) * dxinv * mf   // Contribution to x-mom eqn from diffusive flux in x-dir
                                 + (tau12(i  , j+1, k  ) - tau12(i  , j  ,k  )) * dyinv * mf   // Contribution to x-mom eqn from diffusive flux in y-dir
                                 + (tau13(i  , j  , k+1) - tau13(i  , j  ,k  )) * dzinv );     // Contribution to x-mom eqn from diffusive flux in z-dir;
-            diffContrib      /= 0.5*(detJ(i,j,k) + detJ(i-1,j,k));
+            diffContrib      /= Get_detJ_AtIface(i,j,k,detJ,met_x);
             diffContrib      *= 0.5 * (cons(i,j,k,Rho_comp) + cons(i-1,j,k,Rho_comp))  / solverChoice.rho0_trans;
             rho_u_rhs(i,j,k) += diffContrib;
         },
@@ -45,7 +48,7 @@ DiffusionSrcForMom_T (const Box& bxx, const Box& bxy , const Box& bxz,
             Real diffContrib  = ( (tau21(i+1, j  , k  ) - tau21(i  , j  , k  )) * dxinv * mf   // Contribution to y-mom eqn from diffusive flux in x-dir
                                 + (tau22(i  , j  , k  ) - tau22(i  , j-1, k  )) * dyinv * mf   // Contribution to y-mom eqn from diffusive flux in y-dir
                                 + (tau23(i  , j  , k+1) - tau23(i  , j  , k  )) * dzinv );     // Contribution to y-mom eqn from diffusive flux in z-dir;
-            diffContrib      /= 0.5*(detJ(i,j,k) + detJ(i,j-1,k));
+            diffContrib      /= Get_detJ_AtJface(i,j,k,detJ,met_y);
             diffContrib      *= 0.5 * (cons(i,j,k,Rho_comp) + cons(i,j-1,k,Rho_comp))  / solverChoice.rho0_trans;
             rho_v_rhs(i,j,k) += diffContrib;
         },
@@ -56,7 +59,7 @@ DiffusionSrcForMom_T (const Box& bxx, const Box& bxy , const Box& bxz,
             Real diffContrib  = ( (tau31(i+1, j  , k  ) - tau31(i  , j  , k  )) * dxinv * mf   // Contribution to z-mom eqn from diffusive flux in x-dir
                                 + (tau32(i  , j+1, k  ) - tau32(i  , j  , k  )) * dyinv * mf   // Contribution to z-mom eqn from diffusive flux in y-dir
                                 + (tau33(i  , j  , k  ) - tau33(i  , j  , k-1)) * dzinv );     // Contribution to z-mom eqn from diffusive flux in z-dir;
-            diffContrib      /= 0.5*(detJ(i,j,k) + detJ(i,j,k-1));
+            diffContrib      /= Get_detJ_AtKface(i,j,k,detJ,met_z);
             diffContrib      *= 0.5 * (cons(i,j,k,Rho_comp) + cons(i,j,k-1,Rho_comp))  / solverChoice.rho0_trans;
             rho_w_rhs(i,j,k) += diffContrib;
         });
@@ -70,7 +73,7 @@ DiffusionSrcForMom_T (const Box& bxx, const Box& bxy , const Box& bxz,
             Real diffContrib  = ( (tau11(i  , j  , k  ) - tau11(i-1, j  ,k  )) * dxinv * mf   // Contribution to x-mom eqn from diffusive flux in x-dir
                                 + (tau12(i  , j+1, k  ) - tau12(i  , j  ,k  )) * dyinv * mf   // Contribution to x-mom eqn from diffusive flux in y-dir
                                 + (tau13(i  , j  , k+1) - tau13(i  , j  ,k  )) * dzinv );     // Contribution to x-mom eqn from diffusive flux in z-dir;
-            diffContrib      /= 0.5*(detJ(i,j,k) + detJ(i-1,j,k));
+            diffContrib      /= Get_detJ_AtIface(i,j,k,detJ,met_x);
             rho_u_rhs(i,j,k) += diffContrib;
         },
         [=] AMREX_GPU_DEVICE (int i, int j, int k)
@@ -80,7 +83,7 @@ DiffusionSrcForMom_T (const Box& bxx, const Box& bxy , const Box& bxz,
             Real diffContrib  = ( (tau21(i+1, j  , k  ) - tau21(i  , j  , k  )) * dxinv * mf   // Contribution to y-mom eqn from diffusive flux in x-dir
                                 + (tau22(i  , j  , k  ) - tau22(i  , j-1, k  )) * dyinv * mf   // Contribution to y-mom eqn from diffusive flux in y-dir
                                 + (tau23(i  , j  , k+1) - tau23(i  , j  , k  )) * dzinv );     // Contribution to y-mom eqn from diffusive flux in z-dir;
-            diffContrib      /= 0.5*(detJ(i,j,k) + detJ(i,j-1,k));
+            diffContrib      /= Get_detJ_AtJface(i,j,k,detJ,met_y);
             rho_v_rhs(i,j,k) += diffContrib;
         },
         [=] AMREX_GPU_DEVICE (int i, int j, int k)
@@ -90,7 +93,7 @@ DiffusionSrcForMom_T (const Box& bxx, const Box& bxy , const Box& bxz,
             Real diffContrib  = ( (tau31(i+1, j  , k  ) - tau31(i  , j  , k  )) * dxinv * mf   // Contribution to z-mom eqn from diffusive flux in x-dir
                                 + (tau32(i  , j+1, k  ) - tau32(i  , j  , k  )) * dyinv * mf   // Contribution to z-mom eqn from diffusive flux in y-dir
                                 + (tau33(i  , j  , k  ) - tau33(i  , j  , k-1)) * dzinv );     // Contribution to z-mom eqn from diffusive flux in z-dir;
-            diffContrib      /= 0.5*(detJ(i,j,k) + detJ(i,j,k-1));
+            diffContrib      /= Get_detJ_AtKface(i,j,k,detJ,met_z);
             rho_w_rhs(i,j,k) += diffContrib;
         });
     }
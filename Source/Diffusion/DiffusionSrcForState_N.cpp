@@ -32,17 +32,11 @@ DiffusionSrcForState_N (const amrex::Box& bx, const amrex::Box& domain, int n_st
     const Real dy_inv = cellSizeInv[1];
     const Real dz_inv = cellSizeInv[2];
 
-    bool l_use_QKE       = solverChoice.use_QKE && solverChoice.advect_QKE;
-    bool l_use_deardorff = (solverChoice.les_type == LESType::Deardorff);
-    Real l_Delta         = std::pow(dx_inv * dy_inv * dz_inv,-1./3.);
-    Real l_C_e           = solverChoice.Ce;
-
-    bool l_consA  = (solverChoice.molec_diff_type == MolecDiffType::ConstantAlpha);
-    bool l_turb   = ( (solverChoice.les_type == LESType::Smagorinsky) ||
-                      (solverChoice.les_type == LESType::Deardorff  ) ||
-                      (solverChoice.pbl_type == PBLType::MYNN25     ) );
+    // Theta, KE, QKE, Scalar
+    const ScalarDiffusionCoeffs coeffs = make_scalar_diffusion_coeffs(solverChoice);
 
-    int l_use_terrain = solverChoice.use_terrain;
+    bool l_consA  = coeffs.rho_weighted;
+    bool l_turb   = coeffs.use_turb;
 
     const Box xbx = surroundingNodes(bx,0);
     const Box ybx = surroundingNodes(bx,1);
@@ -51,62 +45,10 @@ DiffusionSrcForState_N (const amrex::Box& bx, const amrex::Box& domain, int n_st
     const int ncomp      = n_end - n_start + 1;
     const int qty_offset = RhoTheta_comp;
 
-    // Theta, KE, QKE, Scalar
-    Vector<Real> alpha_eff(NUM_PRIM, 0.0);
-    if (l_consA) {
-        for (int i = 0; i < NUM_PRIM; ++i) {
-           switch (i) {
-               case PrimTheta_comp:
-                    alpha_eff[PrimTheta_comp] = solverChoice.alpha_T;
-                    break;
-               case PrimScalar_comp:
-                    alpha_eff[PrimScalar_comp] = solverChoice.alpha_C;
-                    break;
-#ifdef ERF_USE_MOISTURE
-               case PrimQt_comp:
-                    alpha_eff[PrimQt_comp] = solverChoice.alpha_C;
-                    break;
-               case PrimQp_comp:
-                    alpha_eff[PrimQp_comp] = solverChoice.alpha_C;
-                    break;
-#endif
-               default:
-                    alpha_eff[i] = 0.0;
-                    break;
-          }
-       }
-    } else {
-        for (int i = 0; i < NUM_PRIM; ++i) {
-           switch (i) {
-               case PrimTheta_comp:
-                    alpha_eff[PrimTheta_comp] = solverChoice.rhoAlpha_T;
-                    break;
-               case PrimScalar_comp:
-                    alpha_eff[PrimScalar_comp] = solverChoice.rhoAlpha_C;
-                    break;
-#ifdef ERF_USE_MOISTURE
-               case PrimQt_comp:
-                    alpha_eff[PrimQt_comp] = solverChoice.rhoAlpha_C;
-                    break;
-               case PrimQp_comp:
-                    alpha_eff[PrimQp_comp] = solverChoice.rhoAlpha_C;
-                    break;
-#endif
-               default:
-                    alpha_eff[i] = 0.0;
-                    break;
-          }
-       }
-    }
-#ifdef ERF_USE_MOISTURE
-    Vector<int> eddy_diff_idx{EddyDiff::Theta_h, EddyDiff::KE_h, EddyDiff::QKE_h, EddyDiff::Scalar_h, EddyDiff::Qt_h, EddyDiff::Qp_h};
-    Vector<int> eddy_diff_idy{EddyDiff::Theta_h, EddyDiff::KE_h, EddyDiff::QKE_h, EddyDiff::Scalar_h, EddyDiff::Qt_h, EddyDiff::Qp_h};
-    Vector<int> eddy_diff_idz{EddyDiff::Theta_v, EddyDiff::KE_v, EddyDiff::QKE_v, EddyDiff::Scalar_v, EddyDiff::Qt_v, EddyDiff::Qp_v};
-#else
-    Vector<int> eddy_diff_idx{EddyDiff::Theta_h, EddyDiff::KE_h, EddyDiff::QKE_h, EddyDiff::Scalar_h};
-    Vector<int> eddy_diff_idy{EddyDiff::Theta_h, EddyDiff::KE_h, EddyDiff::QKE_h, EddyDiff::Scalar_h};
-    Vector<int> eddy_diff_idz{EddyDiff::Theta_v, EddyDiff::KE_v, EddyDiff::QKE_v, EddyDiff::Scalar_v};
-#endif
+    Vector<Real> alpha_eff(coeffs.alpha_eff.begin(), coeffs.alpha_eff.end());
+    Vector<int> eddy_diff_idx(coeffs.eddy_diff_idx_h.begin(), coeffs.eddy_diff_idx_h.end());
+    Vector<int> eddy_diff_idy(coeffs.eddy_diff_idx_h.begin(), coeffs.eddy_diff_idx_h.end());
+    Vector<int> eddy_diff_idz(coeffs.eddy_diff_idx_v.begin(), coeffs.eddy_diff_idx_v.end());
 
     // Device vectors
     Gpu::AsyncVector<Real> alpha_eff_d;
@@ -260,6 +202,20 @@ DiffusionSrcForState_N (const amrex::Box& bx, const amrex::Box& domain, int n_st
         });
     }
 
+    // With erf.use_implicit_vert_diff only the fluxes through the bottom and top of the domain
+    //    are explicit; those through the interior z-faces are applied by ImplicitVertDiff_N.
+    //    KE and QKE are not part of that solve, so all of their fluxes stay here.
+    if (solverChoice.use_implicit_vert_diff) {
+        const int klo = domain.smallEnd(2);
+        const int khi = domain.bigEnd(2);
+        amrex::ParallelFor(zbx, ncomp,[=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+        {
+            const int qty_index = n_start + n;
+            if (k > klo && k <= khi && qty_index != RhoKE_comp && qty_index != RhoQKE_comp) {
+                zflux(i,j,k,qty_index) = 0.0;
+            }
+        });
+    }
 
     // Use fluxes to compute RHS
     for (int qty_index = n_start; qty_index <= n_end; qty_index++)
@@ -276,6 +232,42 @@ DiffusionSrcForState_N (const amrex::Box& bx, const amrex::Box& domain, int n_st
         });
     }
 
+    TKESrc_N(bx, domain, n_end, u, v, w, cell_data, cell_prim, cell_rhs,
+             cellSizeInv, mu_turb, solverChoice, tm_arr, grav_gpu, bc_ptr);
+}
+
+/**
+ * Source terms of the turbulent kinetic energy: buoyancy, production and dissipation for the
+ * Deardorff model, and the MYNN source terms for QKE (only if n_end reaches those components)
+ */
+void
+TKESrc_N (const amrex::Box& bx, const amrex::Box& domain, int n_end,
+          const Array4<const Real>& u,
+          const Array4<const Real>& v,
+          const Array4<const Real>& w,
+          const Array4<const Real>& cell_data,
+          const Array4<const Real>& cell_prim,
+          const Array4<Real>& cell_rhs,
+          const amrex::GpuArray<Real, AMREX_SPACEDIM>& cellSizeInv,
+          const Array4<const Real>& mu_turb,
+          const SolverChoice &solverChoice,
+          const Array4<const Real>& tm_arr,
+          const amrex::GpuArray<Real,AMREX_SPACEDIM> grav_gpu,
+          const amrex::BCRec* bc_ptr)
+{
+    BL_PROFILE_VAR("TKESrc_N()",TKESrc_N);
+
+    const Real dx_inv = cellSizeInv[0];
+    const Real dy_inv = cellSizeInv[1];
+    const Real dz_inv = cellSizeInv[2];
+
+    bool l_use_QKE       = solverChoice.use_QKE && solverChoice.advect_QKE;
+    bool l_use_deardorff = (solverChoice.les_type == LESType::Deardorff);
+    Real l_Delta         = std::pow(dx_inv * dy_inv * dz_inv,-1./3.);
+    Real l_C_e           = solverChoice.Ce;
+
+    int l_use_terrain = solverChoice.use_terrain;
+
     // Using Deardorff
     if (l_use_deardorff && n_end >= RhoKE_comp) {
         int qty_index = RhoKE_comp;
@@ -314,5 +306,41 @@ DiffusionSrcForState_N (const amrex::Box& bx, const amrex::Box& domain, int n_st
                                                                   mu_turb,cellSizeInv,domain,solverChoice,tm_arr(i,j,0));
         });
     }
+}
+
+/**
+ * Diffusion coefficients of the variables RhoTheta_comp and up, indexed by the primitive index
+ */
+ScalarDiffusionCoeffs
+make_scalar_diffusion_coeffs (const SolverChoice& solverChoice)
+{
+    ScalarDiffusionCoeffs c;
+
+    c.rho_weighted = (solverChoice.molec_diff_type == MolecDiffType::ConstantAlpha);
+    c.use_turb     = ( (solverChoice.les_type == LESType::Smagorinsky) ||
+                       (solverChoice.les_type == LESType::Deardorff  ) ||
+                       (solverChoice.pbl_type == PBLType::MYNN25     ) );
+
+    const Real alpha_T = c.rho_weighted ? solverChoice.alpha_T : solverChoice.rhoAlpha_T;
+    const Real alpha_C = c.rho_weighted ? solverChoice.alpha_C : solverChoice.rhoAlpha_C;
+
+    for (int i = 0; i < NUM_PRIM; ++i) {
+        c.alpha_eff[i] = 0.0;
+    }
+    c.alpha_eff[PrimTheta_comp]  = alpha_T;
+    c.alpha_eff[PrimScalar_comp] = alpha_C;
+#ifdef ERF_USE_MOISTURE
+    c.alpha_eff[PrimQt_comp]     = alpha_C;
+    c.alpha_eff[PrimQp_comp]     = alpha_C;
+#endif
+
+#ifdef ERF_USE_MOISTURE
+    c.eddy_diff_idx_h = {EddyDiff::Theta_h, EddyDiff::KE_h, EddyDiff::QKE_h, EddyDiff::Scalar_h, EddyDiff::Qt_h, EddyDiff::Qp_h};
+    c.eddy_diff_idx_v = {EddyDiff::Theta_v, EddyDiff::KE_v, EddyDiff::QKE_v, EddyDiff::Scalar_v, EddyDiff::Qt_v, EddyDiff::Qp_v};
+#else
+    c.eddy_diff_idx_h = {EddyDiff::Theta_h, EddyDiff::KE_h, EddyDiff::QKE_h, EddyDiff::Scalar_h};
+    c.eddy_diff_idx_v = {EddyDiff::Theta_v, EddyDiff::KE_v, EddyDiff::QKE_v, EddyDiff::Scalar_v};
+#endif
 
+    return c;
 }
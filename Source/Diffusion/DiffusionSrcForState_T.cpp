@@ -19,6 +19,9 @@ DiffusionSrcForState_T (const amrex::Box& bx, const amrex::Box& domain, int n_st
                         const Array4<Real>& zflux,
                         const Array4<const Real>& z_nd,
                         const Array4<const Real>& detJ,
+                        const Array4<const Real>& met_x,
+                        const Array4<const Real>& met_y,
+                        const Array4<const Real>& met_z,
                         const amrex::GpuArray<Real, AMREX_SPACEDIM>& dxInv,
                         const Array4<const Real>& mf_m,
                         const Array4<const Real>& mf_u,
@@ -139,8 +142,8 @@ DiffusionSrcForState_T (const amrex::Box& bx, const amrex::Box& domain, int n_st
                               + mu_turb(i-1, j, k, d_eddy_diff_idx[prim_index]) );
 
             Real met_h_xi,met_h_zeta;
-            met_h_xi   = Compute_h_xi_AtIface  (i,j,k,dxInv,z_nd);
-            met_h_zeta = Compute_h_zeta_AtIface(i,j,k,dxInv,z_nd);
+            met_h_xi   = Get_h_xi_AtIface  (i,j,k,dxInv,z_nd,met_x);
+            met_h_zeta = Get_h_zeta_AtIface(i,j,k,dxInv,z_nd,met_x);
 
             Real GradCz = 0.25 * dz_inv * ( cell_prim(i, j, k+1, prim_index) + cell_prim(i-1, j, k+1, prim_index)
                                           - cell_prim(i, j, k-1, prim_index) - cell_prim(i-1, j, k-1, prim_index) );
@@ -159,8 +162,8 @@ DiffusionSrcForState_T (const amrex::Box& bx, const amrex::Box& domain, int n_st
                               + mu_turb(i, j-1, k, d_eddy_diff_idy[prim_index]) );
 
             Real met_h_eta,met_h_zeta;
-            met_h_eta  = Compute_h_eta_AtJface (i,j,k,dxInv,z_nd);
-            met_h_zeta = Compute_h_zeta_AtJface(i,j,k,dxInv,z_nd);
+            met_h_eta  = Get_h_eta_AtJface (i,j,k,dxInv,z_nd,met_y);
+            met_h_zeta = Get_h_zeta_AtJface(i,j,k,dxInv,z_nd,met_y);
 
             Real GradCz = 0.25 * dz_inv * ( cell_prim(i, j, k+1, prim_index) + cell_prim(i, j-1, k+1, prim_index)
                                           - cell_prim(i, j, k-1, prim_index) - cell_prim(i, j-1, k-1, prim_index) );
@@ -179,7 +182,7 @@ DiffusionSrcForState_T (const amrex::Box& bx, const amrex::Box& domain, int n_st
                               + mu_turb(i, j, k-1, d_eddy_diff_idz[prim_index]) );
 
             Real met_h_zeta;
-            met_h_zeta = Compute_h_zeta_AtKface(i,j,k,dxInv,z_nd);
+            met_h_zeta = Get_h_zeta_AtKface(i,j,k,dxInv,z_nd,met_z);
 
             Real GradCz = dz_inv * ( cell_prim(i, j, k, prim_index) - cell_prim(i, j, k-1, prim_index) );
 
@@ -197,8 +200,8 @@ DiffusionSrcForState_T (const amrex::Box& bx, const amrex::Box& domain, int n_st
                            + mu_turb(i-1, j, k, d_eddy_diff_idx[prim_index]) );
 
             Real met_h_xi,met_h_zeta;
-            met_h_xi   = Compute_h_xi_AtIface  (i,j,k,dxInv,z_nd);
-            met_h_zeta = Compute_h_zeta_AtIface(i,j,k,dxInv,z_nd);
+            met_h_xi   = Get_h_xi_AtIface  (i,j,k,dxInv,z_nd,met_x);
+            met_h_zeta = Get_h_zeta_AtIface(i,j,k,dxInv,z_nd,met_x);
 
             Real GradCz = 0.25 * dz_inv * ( cell_prim(i, j, k+1, prim_index) + cell_prim(i-1, j, k+1, prim_index)
                                           - cell_prim(i, j, k-1, prim_index) - cell_prim(i-1, j, k-1, prim_index) );
@@ -216,8 +219,8 @@ DiffusionSrcForState_T (const amrex::Box& bx, const amrex::Box& domain, int n_st
                            + mu_turb(i, j-1, k, d_eddy_diff_idy[prim_index]) );
 
             Real met_h_eta,met_h_zeta;
-            met_h_eta  = Compute_h_eta_AtJface (i,j,k,dxInv,z_nd);
-            met_h_zeta = Compute_h_zeta_AtJface(i,j,k,dxInv,z_nd);
+            met_h_eta  = Get_h_eta_AtJface (i,j,k,dxInv,z_nd,met_y);
+            met_h_zeta = Get_h_zeta_AtJface(i,j,k,dxInv,z_nd,met_y);
 
             Real GradCz = 0.25 * dz_inv * ( cell_prim(i, j, k+1, prim_index) + cell_prim(i, j-1, k+1, prim_index)
                                           - cell_prim(i, j, k-1, prim_index) - cell_prim(i, j-1, k-1, prim_index) );
@@ -236,7 +239,7 @@ DiffusionSrcForState_T (const amrex::Box& bx, const amrex::Box& domain, int n_st
                            + mu_turb(i, j, k-1, d_eddy_diff_idz[prim_index]) );
 
             Real met_h_zeta;
-            met_h_zeta = Compute_h_zeta_AtKface(i,j,k,dxInv,z_nd);
+            met_h_zeta = Get_h_zeta_AtKface(i,j,k,dxInv,z_nd,met_z);
 
             Real GradCz = dz_inv * ( cell_prim(i, j, k, prim_index) - cell_prim(i, j, k-1, prim_index) );
 
@@ -253,8 +256,8 @@ DiffusionSrcForState_T (const amrex::Box& bx, const amrex::Box& domain, int n_st
             Real rhoAlpha = rhoFace * d_alpha_eff[prim_index];
 
             Real met_h_xi,met_h_zeta;
-            met_h_xi   = Compute_h_xi_AtIface  (i,j,k,dxInv,z_nd);
-            met_h_zeta = Compute_h_zeta_AtIface(i,j,k,dxInv,z_nd);
+            met_h_xi   = Get_h_xi_AtIface  (i,j,k,dxInv,z_nd,met_x);
+            met_h_zeta = Get_h_zeta_AtIface(i,j,k,dxInv,z_nd,met_x);
 
             Real GradCz = 0.25 * dz_inv * ( cell_prim(i, j, k+1, prim_index) + cell_prim(i-1, j, k+1, prim_index)
                                           - cell_prim(i, j, k-1, prim_index) - cell_prim(i-1, j, k-1, prim_index) );
@@ -271,8 +274,8 @@ DiffusionSrcForState_T (const amrex::Box& bx, const amrex::Box& domain, int n_st
             Real rhoAlpha = rhoFace * d_alpha_eff[prim_index];
 
             Real met_h_eta,met_h_zeta;
-            met_h_eta  = Compute_h_eta_AtJface (i,j,k,dxInv,z_nd);
-            met_h_zeta = Compute_h_zeta_AtJface(i,j,k,dxInv,z_nd);
+            met_h_eta  = Get_h_eta_AtJface (i,j,k,dxInv,z_nd,met_y);
+            met_h_zeta = Get_h_zeta_AtJface(i,j,k,dxInv,z_nd,met_y);
 
             Real GradCz = 0.25 * dz_inv * ( cell_prim(i, j, k+1, prim_index) + cell_prim(i, j-1, k+1, prim_index)
                                           - cell_prim(i, j, k-1, prim_index) - cell_prim(i, j-1, k-1, prim_index) );
@@ -289,7 +292,7 @@ DiffusionSrcForState_T (const amrex::Box& bx, const amrex::Box& domain, int n_st
             Real rhoAlpha = rhoFace * d_alpha_eff[prim_index];
 
             Real met_h_zeta;
-            met_h_zeta = Compute_h_zeta_AtKface(i,j,k,dxInv,z_nd);
+            met_h_zeta = Get_h_zeta_AtKface(i,j,k,dxInv,z_nd,met_z);
 
             Real GradCz = dz_inv * ( cell_prim(i, j, k, prim_index) - cell_prim(i, j, k-1, prim_index) );
 
@@ -305,8 +308,8 @@ DiffusionSrcForState_T (const amrex::Box& bx, const amrex::Box& domain, int n_st
             Real Alpha = d_alpha_eff[prim_index];
 
             Real met_h_xi,met_h_zeta;
-            met_h_xi   = Compute_h_xi_AtIface  (i,j,k,dxInv,z_nd);
-            met_h_zeta = Compute_h_zeta_AtIface(i,j,k,dxInv,z_nd);
+            met_h_xi   = Get_h_xi_AtIface  (i,j,k,dxInv,z_nd,met_x);
+            met_h_zeta = Get_h_zeta_AtIface(i,j,k,dxInv,z_nd,met_x);
 
             Real GradCz = 0.25 * dz_inv * ( cell_prim(i, j, k+1, prim_index) + cell_prim(i-1, j, k+1, prim_index)
                                           - cell_prim(i, j, k-1, prim_index) - cell_prim(i-1, j, k-1, prim_index) );
@@ -322,8 +325,8 @@ DiffusionSrcForState_T (const amrex::Box& bx, const amrex::Box& domain, int n_st
             Real Alpha = d_alpha_eff[prim_index];
 
             Real met_h_eta,met_h_zeta;
-            met_h_eta  = Compute_h_eta_AtJface (i,j,k,dxInv,z_nd);
-            met_h_zeta = Compute_h_zeta_AtJface(i,j,k,dxInv,z_nd);
+            met_h_eta  = Get_h_eta_AtJface (i,j,k,dxInv,z_nd,met_y);
+            met_h_zeta = Get_h_zeta_AtJface(i,j,k,dxInv,z_nd,met_y);
 
             Real GradCz = 0.25 * dz_inv * ( cell_prim(i, j, k+1, prim_index) + cell_prim(i, j-1, k+1, prim_index)
                                           - cell_prim(i, j, k-1, prim_index) - cell_prim(i, j-1, k-1, prim_index) );
@@ -339,7 +342,7 @@ DiffusionSrcForState_T (const amrex::Box& bx, const amrex::Box& domain, int n_st
             Real Alpha = d_alpha_eff[prim_index];
 
             Real met_h_zeta;
-            met_h_zeta = Compute_h_zeta_AtKface(i,j,k,dxInv,z_nd);
+            met_h_zeta = Get_h_zeta_AtKface(i,j,k,dxInv,z_nd,met_z);
 
             Real GradCz = dz_inv * ( cell_prim(i, j, k, prim_index) - cell_prim(i, j, k-1, prim_index) );
 
@@ -360,8 +363,8 @@ DiffusionSrcForState_T (const amrex::Box& bx, const amrex::Box& domain, int n_st
           Real met_h_xi,met_h_eta;
 
           { // Bottom face
-            met_h_xi  = Compute_h_xi_AtKface (i,j,k_lo,dxInv,z_nd);
-            met_h_eta = Compute_h_eta_AtKface(i,j,k_lo,dxInv,z_nd);
+            met_h_xi  = Get_h_xi_AtKface (i,j,k_lo,dxInv,z_nd,met_z);
+            met_h_eta = Get_h_eta_AtKface(i,j,k_lo,dxInv,z_nd,met_z);
 
             Real xfluxlo  = 0.5 * ( xflux(i  , j  , k_lo  , qty_index) + xflux(i+1, j  , k_lo  , qty_index) );
             Real xfluxhi  = 0.5 * ( xflux(i  , j  , k_lo+1, qty_index) + xflux(i+1, j  , k_lo+1, qty_index) );
@@ -375,8 +378,8 @@ DiffusionSrcForState_T (const amrex::Box& bx, const amrex::Box& domain, int n_st
           }
 
           { // Top face
-            met_h_xi  = Compute_h_xi_AtKface (i,j,k_hi,dxInv,z_nd);
-            met_h_eta = Compute_h_eta_AtKface(i,j,k_hi,dxInv,z_nd);
+            met_h_xi  = Get_h_xi_AtKface (i,j,k_hi,dxInv,z_nd,met_z);
+            met_h_eta = Get_h_eta_AtKface(i,j,k_hi,dxInv,z_nd,met_z);
 
             Real xfluxlo  = 0.5 * ( xflux(i  , j  , k_hi-2, qty_index) + xflux(i+1, j  , k_hi-2, qty_index) );
             Real xfluxhi  = 0.5 * ( xflux(i  , j  , k_hi-1, qty_index) + xflux(i+1, j  , k_hi-1, qty_index) );
@@ -396,8 +399,8 @@ DiffusionSrcForState_T (const amrex::Box& bx, const amrex::Box& domain, int n_st
       const int  qty_index = n_start + n;
 
       Real met_h_xi,met_h_eta;
-      met_h_xi  = Compute_h_xi_AtKface (i,j,k,dxInv,z_nd);
-      met_h_eta = Compute_h_eta_AtKface(i,j,k,dxInv,z_nd);
+      met_h_xi  = Get_h_xi_AtKface (i,j,k,dxInv,z_nd,met_z);
+      met_h_eta = Get_h_eta_AtKface(i,j,k,dxInv,z_nd,met_z);
 
       Real xfluxbar = 0.25 * ( xflux(i  , j  , k  , qty_index) + xflux(i+1, j  , k  , qty_index)
                              + xflux(i  , j  , k-1, qty_index) + xflux(i+1, j  , k-1, qty_index) );
@@ -410,13 +413,13 @@ DiffusionSrcForState_T (const amrex::Box& bx, const amrex::Box& domain, int n_st
     amrex::ParallelFor(xbx, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
     {
       const int  qty_index = n_start + n;
-      Real met_h_zeta      = Compute_h_zeta_AtIface(i,j,k,dxInv,z_nd);
+      Real met_h_zeta      = Get_h_zeta_AtIface(i,j,k,dxInv,z_nd,met_x);
       xflux(i,j,k,qty_index) *= met_h_zeta;
     });
     amrex::ParallelFor(ybx, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
     {
       const int  qty_index = n_start + n;
-      Real met_h_zeta      = Compute_h_zeta_AtJface(i,j,k,dxInv,z_nd);
+      Real met_h_zeta      = Get_h_zeta_AtJface(i,j,k,dxInv,z_nd,met_y);
       yflux(i,j,k,qty_index) *= met_h_zeta;
     });
 
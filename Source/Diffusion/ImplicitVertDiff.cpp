@@ -0,0 +1,281 @@
+#include <Diffusion.H>
+#include <EddyViscosity.H>
+
+using namespace amrex;
+
+/**
+ * Vertical diffusion of the scalars and horizontal momenta treated implicitly
+ * (erf.use_implicit_vert_diff, no terrain only).
+ *
+ * The explicit slow RHS keeps only the fluxes through the bottom and top of the domain (so the
+ * wall fluxes imposed through the ghost cells, e.g. by MOST, are unchanged); the fluxes through
+ * the interior z-faces are instead applied once per step by a backward Euler solve in each column.
+ */
+
+namespace {
+
+/**
+ * Vertical viscosity on the (x,z) edge (i,j,k), i.e. the coefficient of (u(k)-u(k-1))*dz_inv
+ * in tau13 = mu_13 * 0.5 * (du/dz + dw/dx), as in ComputeStress{ConsVisc,VarVisc}_N
+ */
+AMREX_GPU_DEVICE AMREX_FORCE_INLINE
+Real
+vert_visc_xz (int i, int j, int k, Real mu_eff, bool cons_visc,
+              const Array4<const Real>& mu_turb)
+{
+    if (cons_visc) return 0.5 * mu_eff;
+    Real mu_bar = 0.25*( mu_turb(i-1, j, k  , EddyDiff::Mom_v) + mu_turb(i, j, k  , EddyDiff::Mom_v)
+                       + mu_turb(i-1, j, k-1, EddyDiff::Mom_v) + mu_turb(i, j, k-1, EddyDiff::Mom_v) );
+    return mu_bar;
+}
+
+/**
+ * Vertical viscosity on the (y,z) edge (i,j,k), the coefficient of (v(k)-v(k-1))*dz_inv in tau23
+ */
+AMREX_GPU_DEVICE AMREX_FORCE_INLINE
+Real
+vert_visc_yz (int i, int j, int k, Real mu_eff, bool cons_visc,
+              const Array4<const Real>& mu_turb)
+{
+    if (cons_visc) return 0.5 * mu_eff;
+    Real mu_bar = 0.25*( mu_turb(i, j-1, k  , EddyDiff::Mom_v) + mu_turb(i, j, k  , EddyDiff::Mom_v)
+                       + mu_turb(i, j-1, k-1, EddyDiff::Mom_v) + mu_turb(i, j, k-1, EddyDiff::Mom_v) );
+    return mu_bar;
+}
+
+/**
+ * Solve m x_new - dt/dz^2 * [ K(k+1) (x_new(k+1)-x_new(k)) - K(k) (x_new(k)-x_new(k-1)) ] = m x_old
+ * in every (i,j) column of bx, with no flux through the bottom and top faces of bx.
+ * On entry x holds x_old and on exit x_new; cp and dp are scratch covering bx.
+ */
+template <typename MassF, typename CoefF>
+void
+vert_diff_solve (const Box& bx, Real dtdz2,
+                 const Array4<Real>& x, const Array4<Real>& cp, const Array4<Real>& dp,
+                 MassF const& m_of, CoefF const& coef_of)
+{
+    const int klo = bx.smallEnd(2);
+    const int khi = bx.bigEnd(2);
+
+    Box b2d = bx; // Copy constructor
+    b2d.setRange(2,0);
+
+    ParallelFor(b2d, [=] AMREX_GPU_DEVICE (int i, int j, int) noexcept
+    {
+        for (int k = klo; k <= khi; ++k) {
+            Real a = (k == klo) ? 0.0 : -dtdz2 * coef_of(i,j,k  );
+            Real c = (k == khi) ? 0.0 : -dtdz2 * coef_of(i,j,k+1);
+            Real m = m_of(i,j,k);
+            Real b = m - a - c;
+            Real r = m * x(i,j,k);
+            if (k == klo) {
+                cp(i,j,k) = c / b;
+                dp(i,j,k) = r / b;
+            } else {
+                Real inv_b = 1.0 / (b - a * cp(i,j,k-1));
+                cp(i,j,k) = c * inv_b;
+                dp(i,j,k) = (r - a * dp(i,j,k-1)) * inv_b;
+            }
+        }
+        x(i,j,khi) = dp(i,j,khi);
+        for (int k = khi-1; k >= klo; --k) {
+            x(i,j,k) = dp(i,j,k) - cp(i,j,k) * x(i,j,k+1);
+        }
+    });
+}
+
+} // namespace
+
+/**
+ * Remove from the explicit momentum RHS made by DiffusionSrcForMom_N the part of the vertical
+ * flux of x- and y-momentum that is due to du/dz and dv/dz at the interior z-faces
+ *
+ * @param[in]    bxx       x-faces to update
+ * @param[in]    bxy       y-faces to update
+ * @param[in]    domain    cell-centered domain; the faces at its bottom and top stay explicit
+ * @param[inout] rho_u_rhs RHS of the x-momentum
+ * @param[inout] rho_v_rhs RHS of the y-momentum
+ * @param[in]    u         x-velocity the strain was made from
+ * @param[in]    v         y-velocity the strain was made from
+ * @param[in]    cons      conserved variables (density)
+ * @param[in]    mu_turb   eddy viscosity, unused with constant viscosity
+ */
+void
+SubtractVertDiffForMom_N (const Box& bxx, const Box& bxy, const Box& domain,
+                          const Array4<Real>& rho_u_rhs,
+                          const Array4<Real>& rho_v_rhs,
+                          const Array4<const Real>& u,
+                          const Array4<const Real>& v,
+                          const Array4<const Real>& cons,
+                          const Array4<const Real>& mu_turb,
+                          const SolverChoice& solverChoice,
+                          const GpuArray<Real, AMREX_SPACEDIM>& dxInv)
+{
+    BL_PROFILE_VAR("SubtractVertDiffForMom_N()",SubtractVertDiffForMom_N);
+
+    const Real dzinv = dxInv[2];
+    const int  klo   = domain.smallEnd(2);
+    const int  khi   = domain.bigEnd(2);
+
+    const bool cons_visc = ( (solverChoice.molec_diff_type == MolecDiffType::Constant) ||
+                             (solverChoice.molec_diff_type == MolecDiffType::ConstantAlpha) );
+    const bool rho_fac   = (solverChoice.molec_diff_type == MolecDiffType::ConstantAlpha);
+    const Real mu_eff    = cons_visc ? 2.0 * solverChoice.dynamicViscosity : 0.0;
+    const Real rho0_inv  = 1.0 / solverChoice.rho0_trans;
+
+    ParallelFor(bxx, bxy,
+    [=] AMREX_GPU_DEVICE (int i, int j, int k)
+    {
+        Real flux_lo = (k   > klo) ? vert_visc_xz(i,j,k  ,mu_eff,cons_visc,mu_turb) * (u(i,j,k  ) - u(i,j,k-1)) * dzinv : 0.0;
+        Real flux_hi = (k+1 <= khi) ? vert_visc_xz(i,j,k+1,mu_eff,cons_visc,mu_turb) * (u(i,j,k+1) - u(i,j,k  )) * dzinv : 0.0;
+        Real fac = rho_fac ? 0.5 * (cons(i,j,k,Rho_comp) + cons(i-1,j,k,Rho_comp)) * rho0_inv : 1.0;
+        rho_u_rhs(i,j,k) -= fac * (flux_hi - flux_lo) * dzinv;
+    },
+    [=] AMREX_GPU_DEVICE (int i, int j, int k)
+    {
+        Real flux_lo = (k   > klo) ? vert_visc_yz(i,j,k  ,mu_eff,cons_visc,mu_turb) * (v(i,j,k  ) - v(i,j,k-1)) * dzinv : 0.0;
+        Real flux_hi = (k+1 <= khi) ? vert_visc_yz(i,j,k+1,mu_eff,cons_visc,mu_turb) * (v(i,j,k+1) - v(i,j,k  )) * dzinv : 0.0;
+        Real fac = rho_fac ? 0.5 * (cons(i,j,k,Rho_comp) + cons(i,j-1,k,Rho_comp)) * rho0_inv : 1.0;
+        rho_v_rhs(i,j,k) -= fac * (flux_hi - flux_lo) * dzinv;
+    });
+}
+
+/**
+ * Apply the vertical diffusion through the interior z-faces left out of the explicit RHS, by
+ * a backward Euler step of length dt in every column. This updates (rho theta) and the scalars
+ * in cons, and the x- and y-momenta together with the velocities. The coefficients are those of
+ * DiffusionSrcForState_N and ComputeStress*_N, evaluated with the density at the end of the step
+ * and the eddy diffusivities of the start of the step.
+ *
+ * @param[in]    dt        time step
+ * @param[inout] cons      conserved variables
+ * @param[inout] xmom      x-momentum
+ * @param[inout] ymom      y-momentum
+ * @param[inout] xvel      x-velocity, consistent with xmom on entry
+ * @param[inout] yvel      y-velocity, consistent with ymom on entry
+ * @param[in]    eddyDiffs eddy diffusivities, may be null if there is no LES or PBL model
+ */
+void
+ImplicitVertDiff_N (const Real dt,
+                    MultiFab& cons, MultiFab& xmom, MultiFab& ymom,
+                    MultiFab& xvel, MultiFab& yvel,
+                    const MultiFab* eddyDiffs,
+                    const Geometry& geom,
+                    const SolverChoice& solverChoice)
+{
+    BL_PROFILE_VAR("ImplicitVertDiff_N()",ImplicitVertDiff_N);
+
+    const Box& domain = geom.Domain();
+    const Real dz_inv = geom.InvCellSize(2);
+    const Real dtdz2  = dt * dz_inv * dz_inv;
+
+    // Scalars: the components diffused by erf_slow_rhs_pre and erf_slow_rhs_post
+    const ScalarDiffusionCoeffs coeffs = make_scalar_diffusion_coeffs(solverChoice);
+    const bool l_consA = coeffs.rho_weighted;
+    const bool l_turb  = coeffs.use_turb && (eddyDiffs != nullptr);
+    Vector<int> comps = {RhoTheta_comp};
+    for (int n = RhoScalar_comp; n < cons.nComp(); ++n) {
+        comps.push_back(n);
+    }
+
+    // Momenta
+    const bool cons_visc = ( (solverChoice.molec_diff_type == MolecDiffType::Constant) ||
+                             (solverChoice.molec_diff_type == MolecDiffType::ConstantAlpha) );
+    const bool rho_fac   = (solverChoice.molec_diff_type == MolecDiffType::ConstantAlpha);
+    const Real mu_eff    = cons_visc ? 2.0 * solverChoice.dynamicViscosity : 0.0;
+    const Real rho0      = solverChoice.rho0_trans;
+
+#ifdef _OPENMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+    {
+    FArrayBox tmp_fab;
+    // The solve runs along whole columns, so the boxes are not tiled
+    for (MFIter mfi(cons); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.validbox();
+        AMREX_ALWAYS_ASSERT(bx.smallEnd(2) == domain.smallEnd(2) && bx.bigEnd(2) == domain.bigEnd(2));
+
+        Box tmp_bx = bx;
+        tmp_bx.surroundingNodes(0).surroundingNodes(1);
+        tmp_fab.resize(tmp_bx, 3);
+        Elixir tmp_eli = tmp_fab.elixir();
+        const Array4<Real>& x_arr  = tmp_fab.array(0);
+        const Array4<Real>& cp_arr = tmp_fab.array(1);
+        const Array4<Real>& dp_arr = tmp_fab.array(2);
+
+        const Array4<Real>& cell_data = cons.array(mfi);
+        const Array4<Real>& rho_u     = xmom.array(mfi);
+        const Array4<Real>& rho_v     = ymom.array(mfi);
+        const Array4<Real>& u         = xvel.array(mfi);
+        const Array4<Real>& v         = yvel.array(mfi);
+        const Array4<const Real>& mu_turb = eddyDiffs ? eddyDiffs->const_array(mfi) : Array4<const Real>{};
+
+        for (int qty_index : comps)
+        {
+            const int  prim_index = qty_index - RhoTheta_comp;
+            const Real alpha      = coeffs.alpha_eff[prim_index];
+            const int  idz        = coeffs.eddy_diff_idx_v[prim_index];
+
+            ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                x_arr(i,j,k) = cell_data(i,j,k,qty_index) / cell_data(i,j,k,Rho_comp);
+            });
+
+            vert_diff_solve(bx, dtdz2, x_arr, cp_arr, dp_arr,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                return cell_data(i,j,k,Rho_comp);
+            },
+            [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                Real rhoAlpha = l_consA ? 0.5 * ( cell_data(i,j,k,Rho_comp) + cell_data(i,j,k-1,Rho_comp) ) * alpha
+                                        : alpha;
+                if (l_turb) {
+                    rhoAlpha += 0.5 * ( mu_turb(i,j,k,idz) + mu_turb(i,j,k-1,idz) );
+                }
+                return rhoAlpha;
+            });
+
+            ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                cell_data(i,j,k,qty_index) = cell_data(i,j,k,Rho_comp) * x_arr(i,j,k);
+            });
+        }
+
+        // With constant kinematic viscosity the diffusive term is scaled by rho/rho0_trans,
+        //    so the rows are divided by that factor and the mass term is rho0_trans
+        Box xbx = surroundingNodes(bx,0);
+        vert_diff_solve(xbx, dtdz2, u, cp_arr, dp_arr,
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            return rho_fac ? rho0 : 0.5 * ( cell_data(i,j,k,Rho_comp) + cell_data(i-1,j,k,Rho_comp) );
+        },
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            return vert_visc_xz(i,j,k,mu_eff,cons_visc,mu_turb);
+        });
+
+        Box ybx = surroundingNodes(bx,1);
+        vert_diff_solve(ybx, dtdz2, v, cp_arr, dp_arr,
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            return rho_fac ? rho0 : 0.5 * ( cell_data(i,j,k,Rho_comp) + cell_data(i,j-1,k,Rho_comp) );
+        },
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            return vert_visc_yz(i,j,k,mu_eff,cons_visc,mu_turb);
+        });
+
+        ParallelFor(xbx, ybx,
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            rho_u(i,j,k) = 0.5 * ( cell_data(i,j,k,Rho_comp) + cell_data(i-1,j,k,Rho_comp) ) * u(i,j,k);
+        },
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            rho_v(i,j,k) = 0.5 * ( cell_data(i,j,k,Rho_comp) + cell_data(i,j-1,k,Rho_comp) ) * v(i,j,k);
+        });
+    } // mfi
+    } // omp
+}
@@ -0,0 +1,39 @@
+#include <Diffusion.H>
+
+using namespace amrex;
+
+/**
+ * Scratch storage for the strain and stress of a single tile (erf.use_tiled_stress), in place
+ * of the level-wide Tau MultiFabs. Every component covers the nodes surrounding bxcc, i.e. the
+ * tile grown by one cell in x and y, which holds each of the boxes used in ComputeStrain_N/T.
+ *
+ * @param[in]  bxcc        tile grown by one cell in x and y
+ * @param[in]  use_terrain also alias tau21, tau31 and tau32
+ * @param[out] tau_fab     scratch to resize; the caller keeps it (and its Elixir) alive
+ */
+void
+ResizeTileStress(const Box& bxcc, bool use_terrain, FArrayBox& tau_fab,
+                 Array4<Real>& tau11, Array4<Real>& tau22, Array4<Real>& tau33,
+                 Array4<Real>& tau12, Array4<Real>& tau13,
+                 Array4<Real>& tau21, Array4<Real>& tau23,
+                 Array4<Real>& tau31, Array4<Real>& tau32)
+{
+    int ncomp = (use_terrain) ? 9 : 6;
+    tau_fab.resize(surroundingNodes(bxcc), ncomp);
+
+    tau11 = tau_fab.array(0);
+    tau22 = tau_fab.array(1);
+    tau33 = tau_fab.array(2);
+    tau12 = tau_fab.array(3);
+    tau13 = tau_fab.array(4);
+    tau23 = tau_fab.array(5);
+    if (use_terrain) {
+        tau21 = tau_fab.array(6);
+        tau31 = tau_fab.array(7);
+        tau32 = tau_fab.array(8);
+    } else {
+        tau21 = Array4<Real>{};
+        tau31 = Array4<Real>{};
+        tau32 = Array4<Real>{};
+    }
+}
@@ -32,6 +32,12 @@ amrex::Real ERF::init_shrink   =  1.0;
 amrex::Real ERF::change_max    =  1.1;
 int         ERF::fixed_mri_dt_ratio = 0;
 bool        ERF::use_lowM_dt = false;
+int         ERF::adaptive_substepping = 0;
+int         ERF::adaptive_dt        = 0;
+amrex::Real ERF::adaptive_dt_rtol   = 1.e-3;
+amrex::Real ERF::adaptive_dt_atol   = 1.e-6;
+amrex::Real ERF::adaptive_dt_safety = 0.9;
+int         ERF::adaptive_dt_max_retries = 10;
 
 // Type of mesh refinement algorithm
 std::string ERF::coupling_type = "OneWay";
@@ -45,6 +51,11 @@ int         ERF::verbose       = 0;
 int         ERF::use_native_mri = 1;
 int         ERF::no_substepping = 0;
 
+// Slow coupling coefficients of the MRI integrator
+std::string ERF::mri_scheme = "WickerSkamarock3";
+amrex::Vector<amrex::Real> ERF::mri_butcher_a;
+amrex::Vector<amrex::Real> ERF::mri_butcher_b;
+
 // Frequency of diagnostic output
 int         ERF::sum_interval  = -1;
 amrex::Real ERF::sum_per       = -1.0;
@@ -61,6 +72,13 @@ amrex::Vector<amrex::Vector<std::string>> ERF::nc_init_file = {{""}}; // Must pr
 // NetCDF wrfbdy (lateral boundary) file
 std::string ERF::nc_bdy_file = ""; // Must provide via input
 
+// Read the wrfbdy file a time level at a time, as needed, rather than all at once
+bool ERF::wrfbdy_streaming = false;
+
+// Width of the wrfbdy lateral boundary zone, and of the specified zone within it
+int ERF::wrfbdy_width     = 1;
+int ERF::wrfbdy_set_width = 1;
+
 // Text input_sounding file
 std::string ERF::input_sounding_file = "input_sounding";
 
@@ -161,6 +179,9 @@ ERF::ERF ()
 
     mri_integrator_mem.resize(nlevs_max);
     physbcs.resize(nlevs_max);
+    workspace.resize(nlevs_max);
+    ghost_exchange.resize(nlevs_max);
+    fill_patcher.resize(nlevs_max);
 
     flux_registers.resize(nlevs_max);
 
@@ -191,12 +212,18 @@ ERF::Evolve ()
 {
     Real cur_time = t_new[0];
 
+    // Wall-clock time of the coarse steps, for reporting their jitter
+    int  num_steps_timed = 0;
+    Real step_time_sum = 0.0, step_time_sq_sum = 0.0, step_time_max = 0.0;
+
     // Take one coarse timestep by calling timeStep -- which recursively calls timeStep
     //      for finer levels (with or without subcycling)
     for (int step = istep[0]; step < max_step && cur_time < stop_time; ++step)
     {
         amrex::Print() << "\nCoarse STEP " << step+1 << " starts ..." << std::endl;
 
+        Real step_start = amrex::second();
+
         ComputeDt();
 
         // Make sure we have read enough of the boundary plane data to make it through this timestep
@@ -216,6 +243,15 @@ ERF::Evolve ()
 
         post_timestep(step, cur_time, dt[0]);
 
+        if (input_bndry_planes) {
+            Real step_time = amrex::second() - step_start;
+            ParallelDescriptor::ReduceRealMax(step_time);
+            num_steps_timed++;
+            step_time_sum    += step_time;
+            step_time_sq_sum += step_time * step_time;
+            step_time_max     = std::max(step_time_max, step_time);
+        }
+
         if (plot_int_1 > 0 && (step+1) % plot_int_1 == 0) {
             last_plot_file_step_1 = step+1;
             WritePlotFile(1,plot_var_names_1);
@@ -248,6 +284,20 @@ ERF::Evolve ()
         if (cur_time >= stop_time - 1.e-6*dt[0]) break;
     }
 
+    if (input_bndry_planes && num_steps_timed > 0) {
+        // Reading the boundary planes shows up as spikes in the step time
+        Real mean = step_time_sum / num_steps_timed;
+        Real var  = std::max(step_time_sq_sum / num_steps_timed - mean * mean, Real(0.0));
+        amrex::Print() << "Coarse step time: mean " << mean << " s, max " << step_time_max
+                       << " s, standard deviation " << std::sqrt(var) << " s over "
+                       << num_steps_timed << " steps" << std::endl;
+    }
+
+    if (adaptive_dt) {
+        amrex::Print() << "Adaptive dt: " << num_steps_accepted << " steps accepted, "
+                       << num_steps_rejected << " steps rejected" << std::endl;
+    }
+
     if (plot_int_1 > 0 && istep[0] > last_plot_file_step_1) {
         WritePlotFile(1,plot_var_names_1);
     }
@@ -292,6 +342,37 @@ ERF::post_timestep (int nstep, Real time, Real dt_lev0)
         sum_integrated_quantities(time);
     }
 
+    for (int lev = 0; lev <= finest_level; lev++) {
+        if (verbose > 1) workspace[lev]->print_step_stats(lev);
+        workspace[lev]->reset_step_stats();
+        if (verbose > 1 && ghost_exchange[lev]->num_fills_this_step() > 0) {
+            ghost_exchange[lev]->print_step_stats(lev);
+        }
+        ghost_exchange[lev]->reset_step_stats();
+        if (verbose > 1) physbcs[lev]->print_step_stats();
+        physbcs[lev]->reset_step_stats();
+    }
+    if (verbose > 1 && fill_tracker.num_fills_this_step() > 0) {
+        fill_tracker.print_step_stats();
+    }
+    fill_tracker.reset_step_stats();
+
+    if (m_r2d) {
+        if (verbose > 1 && m_r2d->num_reads_this_step() > 0) {
+            m_r2d->print_step_stats();
+        }
+        m_r2d->reset_step_stats();
+    }
+
+#ifdef ERF_USE_NETCDF
+    if (wrfbdy_stream) {
+        if (verbose > 1 && wrfbdy_stream->num_loads_this_step() > 0) {
+            wrfbdy_stream->print_step_stats();
+        }
+        wrfbdy_stream->reset_step_stats();
+    }
+#endif
+
     if (output_1d_column) {
 #ifdef ERF_USE_NETCDF
       if (is_it_time_for_action(nstep, time, dt_lev0, column_interval, column_per))
@@ -393,6 +474,9 @@ ERF::InitData ()
                     init_terrain_grid(geom[lev],*z_phys_nd[lev]);
                     make_J(geom[lev],*z_phys_nd[lev],*detJ_cc[lev]);
                     make_zcc(geom[lev],*z_phys_nd[lev],*z_phys_cc[lev]);
+                    if (solverChoice.use_metric_cache) {
+                        make_face_metrics(geom[lev],*z_phys_nd[lev],*detJ_cc[lev],face_metrics[lev]);
+                    }
                 }
             }
         }
@@ -413,6 +497,9 @@ ERF::InitData ()
             for (int lev = finest_level; lev >= 0; --lev) {
                 make_J  (geom[lev],*z_phys_nd[lev],*detJ_cc[lev]);
                 make_zcc(geom[lev],*z_phys_nd[lev],*z_phys_cc[lev]);
+                if (solverChoice.use_metric_cache) {
+                    make_face_metrics(geom[lev],*z_phys_nd[lev],*detJ_cc[lev],face_metrics[lev]);
+                }
             }
         }
     }
@@ -511,6 +598,16 @@ ERF::InitData ()
         FillPatch(lev, t_new[lev],
                   {&lev_new[Vars::cons],&lev_new[Vars::xvel],&lev_new[Vars::yvel],&lev_new[Vars::zvel]});
 
+        // Start the anelastic solver from velocities that satisfy the constraint
+        if (solverChoice.anelastic && restart_chkfile == "") {
+            project_initial_velocities(lev);
+        }
+
+        // The tracers start out with the mixing ratio of the advected scalar
+        if (solverChoice.num_tracers > 0 && restart_chkfile == "") {
+            init_tracers(lev);
+        }
+
         // Copy from new into old just in case
         int ngs   = lev_new[Vars::cons].nGrow();
         int ngvel = lev_new[Vars::xvel].nGrow();
@@ -518,6 +615,7 @@ ERF::InitData ()
         MultiFab::Copy(lev_old[Vars::xvel],lev_new[Vars::xvel],0,0,1,ngvel);
         MultiFab::Copy(lev_old[Vars::yvel],lev_new[Vars::yvel],0,0,1,ngvel);
         MultiFab::Copy(lev_old[Vars::zvel],lev_new[Vars::zvel],0,0,1,IntVect(ngvel,ngvel,0));
+        fill_tracker.touch(lev_old);
 
         // For moving terrain only
         if (solverChoice.terrain_type > 0) {
@@ -554,6 +652,9 @@ ERF::MakeNewLevelFromCoarse (int lev, Real time, const BoxArray& ba,
     auto& lev_new = vars_new[lev];
     auto& lev_old = vars_old[lev];
 
+    fill_tracker.touch(lev_new);
+    fill_tracker.touch(lev_old);
+
     // ********************************************************************************************
     // These are the persistent containers for the old and new data
     // ********************************************************************************************
@@ -651,6 +752,8 @@ ERF::RemakeLevel (int lev, Real time, const BoxArray& ba, const DistributionMapp
         std::swap(temp_lev_new[var_idx], vars_new[lev][var_idx]);
         std::swap(temp_lev_old[var_idx], vars_old[lev][var_idx]);
     }
+    fill_tracker.touch(vars_new[lev]);
+    fill_tracker.touch(vars_old[lev]);
 
     t_new[lev] = time;
     t_old[lev] = time - 1.e200;
@@ -667,6 +770,8 @@ ERF::ClearLevel (int lev)
         vars_new[lev][var_idx].clear();
         vars_old[lev][var_idx].clear();
     }
+    fill_tracker.touch(vars_new[lev]);
+    fill_tracker.touch(vars_old[lev]);
 
     rU_new[lev].clear();
     rU_old[lev].clear();
@@ -678,6 +783,9 @@ ERF::ClearLevel (int lev)
     // Clears the integrator memory
     mri_integrator_mem[lev].reset();
     physbcs[lev].reset();
+    workspace[lev].reset();
+    ghost_exchange[lev].reset();
+    fill_patcher[lev].clear();
 
     grids_to_evolve[lev].clear();
 }
@@ -704,6 +812,9 @@ void ERF::MakeNewLevelFromScratch (int lev, Real /*time*/, const BoxArray& ba,
     auto& lev_new = vars_new[lev];
     auto& lev_old = vars_old[lev];
 
+    fill_tracker.touch(lev_new);
+    fill_tracker.touch(lev_old);
+
     lev_new[Vars::cons].define(ba, dm, Cons::NumVars, ngrow_state);
     lev_old[Vars::cons].define(ba, dm, Cons::NumVars, ngrow_state);
 
@@ -752,6 +863,8 @@ void ERF::MakeNewLevelFromScratch (int lev, Real /*time*/, const BoxArray& ba,
 
     z_t_rk.resize(lev+1);
 
+    face_metrics.resize(lev+1);
+
     // ********************************************************************************************
     // Map factors
     // ********************************************************************************************
@@ -764,9 +877,10 @@ void ERF::MakeNewLevelFromScratch (int lev, Real /*time*/, const BoxArray& ba,
     mapfac_m.resize(lev+1);
     mapfac_u.resize(lev+1);
     mapfac_v.resize(lev+1);
-    mapfac_m[lev].reset(new MultiFab(ba2d,dm,1,3));
-    mapfac_u[lev].reset(new MultiFab(convert(ba2d,IntVect(1,0,0)),dm,1,3));
-    mapfac_v[lev].reset(new MultiFab(convert(ba2d,IntVect(0,1,0)),dm,1,3));
+    int ngrow_mapfac = std::max(3, solverChoice.fast_halo_depth);
+    mapfac_m[lev].reset(new MultiFab(ba2d,dm,1,ngrow_mapfac));
+    mapfac_u[lev].reset(new MultiFab(convert(ba2d,IntVect(1,0,0)),dm,1,ngrow_mapfac));
+    mapfac_v[lev].reset(new MultiFab(convert(ba2d,IntVect(0,1,0)),dm,1,ngrow_mapfac));
     if(solverChoice.test_mapfactor) {
         mapfac_m[lev]->setVal(0.5);
         mapfac_u[lev]->setVal(0.5);
@@ -785,6 +899,32 @@ void ERF::MakeNewLevelFromScratch (int lev, Real /*time*/, const BoxArray& ba,
     base_state[lev].define(ba,dm,3,1);
     base_state[lev].setVal(0.);
 
+    // ********************************************************************************************
+    // Perturbational pressure of the anelastic solver, accumulated by the projections
+    // ********************************************************************************************
+    if (solverChoice.anelastic) {
+        pp_inc.resize(lev+1);
+        pp_inc[lev].define(ba,dm,1,1);
+        pp_inc[lev].setVal(0.);
+    }
+
+    // ********************************************************************************************
+    // Passive tracers (rho times the mixing ratio), which have their own MultiFab
+    // ********************************************************************************************
+    if (solverChoice.num_tracers > 0) {
+        tracers_new.resize(lev+1);
+        tracers_old.resize(lev+1);
+        // The semi-Lagrangian fluxes reach up to tracer_max_courant cells upwind, plus the slopes
+        int ngrow_tracers = ngrow_state;
+        if (solverChoice.tracer_transport == TracerTransportType::SemiLagrangian) {
+            ngrow_tracers = std::max(ngrow_state, solverChoice.tracer_max_courant+2);
+        }
+        tracers_new[lev].define(ba, dm, solverChoice.num_tracers, ngrow_tracers);
+        tracers_old[lev].define(ba, dm, solverChoice.num_tracers, ngrow_tracers);
+        tracers_new[lev].setVal(0.);
+        tracers_old[lev].setVal(0.);
+    }
+
     if (solverChoice.use_terrain && solverChoice.terrain_type > 0) {
         base_state_new.resize(lev+1);
         base_state_new[lev].define(ba,dm,3,1);
@@ -811,6 +951,17 @@ void ERF::MakeNewLevelFromScratch (int lev, Real /*time*/, const BoxArray& ba,
             z_phys_nd_new[lev].reset(new MultiFab(ba_nd,dm,1,IntVect(ngrow,ngrow,1)));
             z_phys_nd_src[lev].reset(new MultiFab(ba_nd,dm,1,IntVect(ngrow,ngrow,1)));
         }
+
+        // The kernels need the metric terms one face beyond the grids in the horizontal,
+        //    e.g. to make the expansion rate in the ghost cells
+        face_metrics[lev].clear();
+        if (solverChoice.use_metric_cache) {
+            face_metrics[lev].resize(AMREX_SPACEDIM);
+            face_metrics[lev][0].define(convert(ba,IntVect(1,0,0)), dm, FaceMetric::NumComps, IntVect(1,1,0));
+            face_metrics[lev][1].define(convert(ba,IntVect(0,1,0)), dm, FaceMetric::NumComps, IntVect(1,1,0));
+            face_metrics[lev][2].define(convert(ba,IntVect(0,0,1)), dm, FaceMetric::NumComps, IntVect(1,1,0));
+            for (auto& mf : face_metrics[lev]) mf.setVal(0.);
+        }
     } else {
             z_phys_nd[lev] = nullptr;
             z_phys_cc[lev] = nullptr;
@@ -862,10 +1013,28 @@ ERF::initialize_integrator(int lev, MultiFab& cons_mf, MultiFab& vel_mf)
 
     mri_integrator_mem[lev] = std::make_unique<MRISplitIntegrator<amrex::Vector<amrex::MultiFab> > >(int_state);
     mri_integrator_mem[lev]->setNoSubstepping(no_substepping);
+    mri_integrator_mem[lev]->set_tableau(make_mri_tableau(mri_scheme, mri_butcher_a, mri_butcher_b));
+    if (adaptive_dt) {
+        mri_integrator_mem[lev]->set_error_control(adaptive_dt_rtol, adaptive_dt_atol);
+    }
 
     physbcs[lev] = std::make_unique<ERFPhysBCFunct> (lev, geom[lev], domain_bcs_type, domain_bcs_type_d,
                                                      solverChoice.terrain_type, m_bc_extdir_vals,
                                                      z_phys_nd[lev], detJ_cc[lev]);
+
+    // Any scratch buffers and exchange plans built on the old grids are no longer usable
+    workspace[lev] = std::make_unique<ERFWorkspace>();
+    ghost_exchange[lev] = std::make_unique<ERFGhostExchange>();
+
+    fill_patcher[lev].clear();
+    if (lev > 0) {
+        fill_patcher[lev].push_back(std::make_unique<ERFFillPatcher>(geom[lev], geom[lev-1], refRatio(lev-1),
+                                                                     &cell_cons_interp));
+        for (int var_idx = Vars::xvel; var_idx <= Vars::zvel; ++var_idx) {
+            fill_patcher[lev].push_back(std::make_unique<ERFFillPatcher>(geom[lev], geom[lev-1], refRatio(lev-1),
+                                                                         &face_linear_interp));
+        }
+    }
 }
 
 void
@@ -954,6 +1123,9 @@ ERF::ReadParameters ()
         // Use the native ERF MRI integrator
         pp.query("use_native_mri", use_native_mri);
         pp.query("no_substepping", no_substepping);
+        if (no_substepping < 0 || no_substepping > 2) {
+            amrex::Abort("erf.no_substepping must be 0, 1 or 2");
+        }
 
         // Frequency of diagnostic output
         pp.query("sum_interval", sum_interval);
@@ -969,6 +1141,41 @@ ERF::ReadParameters ()
         pp.query("fixed_mri_dt_ratio", fixed_mri_dt_ratio);
         pp.query("use_lowM_dt", use_lowM_dt);
 
+        pp.query("adaptive_substepping", adaptive_substepping);
+        if (adaptive_substepping && no_substepping) {
+            amrex::Abort("erf.adaptive_substepping requires erf.no_substepping = 0");
+        }
+
+        pp.query("mri_scheme", mri_scheme);
+        if (mri_scheme == "Custom") {
+            pp.getarr("mri_butcher_a", mri_butcher_a);
+            pp.getarr("mri_butcher_b", mri_butcher_b);
+        }
+        if (mri_scheme != "WickerSkamarock3") {
+            if (max_level > 0) {
+                amrex::Abort("erf.mri_scheme other than WickerSkamarock3 is only implemented for a single level");
+            }
+            // Build the tableau once here so that bad coefficients are caught up front
+            make_mri_tableau(mri_scheme, mri_butcher_a, mri_butcher_b);
+        }
+        pp.query("adaptive_dt", adaptive_dt);
+        pp.query("adaptive_dt_rtol", adaptive_dt_rtol);
+        pp.query("adaptive_dt_atol", adaptive_dt_atol);
+        pp.query("adaptive_dt_safety", adaptive_dt_safety);
+        pp.query("adaptive_dt_max_retries", adaptive_dt_max_retries);
+
+        if (adaptive_dt) {
+            if (fixed_dt > 0.) {
+                amrex::Abort("erf.adaptive_dt cannot be used with erf.fixed_dt");
+            }
+            if (max_level > 0) {
+                amrex::Abort("erf.adaptive_dt is only implemented for a single level");
+            }
+            if (adaptive_dt_rtol <= 0. && adaptive_dt_atol <= 0.) {
+                amrex::Abort("erf.adaptive_dt needs a positive rtol or atol");
+            }
+        }
+
         if (fixed_dt > 0. && fixed_fast_dt > 0.) {
             if (fixed_mri_dt_ratio > 0 &&
                fixed_dt / fixed_fast_dt != fixed_mri_dt_ratio)
@@ -1039,6 +1246,16 @@ ERF::ReadParameters ()
 
         // NetCDF wrfbdy lateral boundary file
         pp.query("nc_bdy_file", nc_bdy_file);
+
+        // Read the wrfbdy file a time level at a time, as needed?
+        pp.query("wrfbdy_streaming", wrfbdy_streaming);
+
+        // Width of the lateral boundary zone, and how much of it is specified rather than relaxed?
+        pp.query("wrfbdy_width", wrfbdy_width);
+        pp.query("wrfbdy_set_width", wrfbdy_set_width);
+        if (wrfbdy_set_width < 1 || wrfbdy_set_width > wrfbdy_width) {
+            amrex::Abort("erf.wrfbdy_set_width must be between 1 and erf.wrfbdy_width");
+        }
 #endif
 
         // Text input_sounding file
@@ -1083,6 +1300,32 @@ ERF::ReadParameters ()
 #endif
 
     solverChoice.init_params();
+
+    if (solverChoice.fast_halo_depth > 1 && max_level > 0) {
+        amrex::Abort("erf.fast_halo_depth > 1 is only implemented for a single level");
+    }
+
+    if (mri_scheme != "WickerSkamarock3" && solverChoice.use_terrain && solverChoice.terrain_type == 1) {
+        amrex::Abort("erf.mri_scheme other than WickerSkamarock3 is not implemented for moving terrain");
+    }
+
+    if (solverChoice.anelastic) {
+        if (no_substepping != 1) {
+            amrex::Abort("erf.anelastic requires erf.no_substepping = 1");
+        }
+        if (max_level > 0) {
+            amrex::Abort("erf.anelastic is only implemented for a single level");
+        }
+    }
+
+    if (solverChoice.num_tracers > 0) {
+        if (max_level > 0) {
+            amrex::Abort("erf.num_tracers > 0 is only implemented for a single level");
+        }
+        if (solverChoice.tracer_transport == TracerTransportType::Eulerian && mri_scheme != "WickerSkamarock3") {
+            amrex::Abort("erf.num_tracers > 0 with erf.tracer_transport = Eulerian is only implemented with erf.mri_scheme = WickerSkamarock3");
+        }
+    }
 }
 
 // Create horizontal average quantities
@@ -1207,6 +1450,7 @@ ERF::AverageDown ()
 void
 ERF::AverageDownTo (int crse_lev)
 {
+    fill_tracker.touch(vars_new[crse_lev]);
     for (int var_idx = 0; var_idx < Vars::NumTypes; ++var_idx) {
         const BoxArray& ba(vars_new[crse_lev][var_idx].boxArray());
         if (ba[0].type() == IntVect::TheZeroVector())
@@ -1224,9 +1468,10 @@ ERF::define_grids_to_evolve (int lev)
    Box domain(geom[lev].Domain());
    if (lev == 0 && init_type == "real")
    {
+      // The specified zone is filled from the wrfbdy data, not evolved
       Box shrunk_domain(domain);
-      shrunk_domain.grow(0,-1);
-      shrunk_domain.grow(1,-1);
+      shrunk_domain.grow(0,-wrfbdy_set_width);
+      shrunk_domain.grow(1,-wrfbdy_set_width);
       grids_to_evolve[lev] = amrex::intersect(grids[lev],shrunk_domain);
    } else if (lev == 1) {
       Box shrunk_domain(boxes_at_level[lev][0]);
@@ -1320,6 +1565,9 @@ ERF::ERF (const amrex::RealBox& rb, int max_level_in,
 
     mri_integrator_mem.resize(nlevs_max);
     physbcs.resize(nlevs_max);
+    workspace.resize(nlevs_max);
+    ghost_exchange.resize(nlevs_max);
+    fill_patcher.resize(nlevs_max);
 
     // Multiblock: public domain sizes (need to know which vars are nodal)
     Box nbx;
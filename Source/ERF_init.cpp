@@ -117,6 +117,9 @@ ERF::init_from_wrfinput(int lev)
 
         make_J  (geom[lev],*z_phys_nd[lev],*  detJ_cc[lev]);
         make_zcc(geom[lev],*z_phys_nd[lev],*z_phys_cc[lev]);
+        if (solverChoice.use_metric_cache) {
+            make_face_metrics(geom[lev],*z_phys_nd[lev],*detJ_cc[lev],face_metrics[lev]);
+        }
 
     } // use_terrain
 
@@ -140,30 +143,67 @@ ERF::init_from_wrfinput(int lev)
     if (init_type == "real" && (lev == 0)) {
         if (nc_bdy_file.empty())
             amrex::Error("NetCDF boundary file name must be provided via input");
-        bdy_time_interval = read_from_wrfbdy(nc_bdy_file,geom[0].Domain(),bdy_data_xlo,bdy_data_xhi,bdy_data_ylo,bdy_data_yhi);
-
-        const Box& domain = geom[lev].Domain();
-
-        convert_wrfbdy_data(0,domain,bdy_data_xlo,
-                            NC_MUB_fab[0], NC_MSFU_fab[0], NC_MSFV_fab[0], NC_MSFM_fab[0],
-                            NC_PH_fab[0] , NC_PHB_fab[0],
-                            NC_C1H_fab[0], NC_C2H_fab[0], NC_RDNW_fab[0],
-                            NC_xvel_fab[0],NC_yvel_fab[0],NC_rho_fab[0],NC_rhoth_fab[0]);
-        convert_wrfbdy_data(1,domain,bdy_data_xhi,
-                            NC_MUB_fab[0], NC_MSFU_fab[0], NC_MSFV_fab[0], NC_MSFM_fab[0],
-                            NC_PH_fab[0] , NC_PHB_fab[0],
-                            NC_C1H_fab[0], NC_C2H_fab[0], NC_RDNW_fab[0],
-                            NC_xvel_fab[0],NC_yvel_fab[0],NC_rho_fab[0],NC_rhoth_fab[0]);
-        convert_wrfbdy_data(2,domain,bdy_data_ylo,
-                            NC_MUB_fab[0], NC_MSFU_fab[0], NC_MSFV_fab[0], NC_MSFM_fab[0],
-                            NC_PH_fab[0] , NC_PHB_fab[0],
-                            NC_C1H_fab[0], NC_C2H_fab[0], NC_RDNW_fab[0],
-                            NC_xvel_fab[0],NC_yvel_fab[0],NC_rho_fab[0],NC_rhoth_fab[0]);
-        convert_wrfbdy_data(3,domain,bdy_data_yhi,
-                            NC_MUB_fab[0], NC_MSFU_fab[0], NC_MSFV_fab[0], NC_MSFM_fab[0],
-                            NC_PH_fab[0] , NC_PHB_fab[0],
-                            NC_C1H_fab[0], NC_C2H_fab[0], NC_RDNW_fab[0],
-                            NC_xvel_fab[0],NC_yvel_fab[0],NC_rho_fab[0],NC_rhoth_fab[0]);
+
+        Real start_bdy = amrex::second();
+
+        if (wrfbdy_streaming) {
+            int nghost = std::max({lev_new[Vars::cons].nGrowVect().max(),
+                                   lev_new[Vars::xvel].nGrowVect().max(),
+                                   lev_new[Vars::yvel].nGrowVect().max()});
+            wrfbdy_stream = std::make_unique<WRFBdyStream>(nc_bdy_file, geom[0].Domain(), grids[0], dmap[0], nghost);
+            wrfbdy_stream->set_wrfinput_fields(NC_MUB_fab[0], NC_PH_fab[0], NC_PHB_fab[0],
+                                               NC_C1H_fab[0], NC_C2H_fab[0], NC_RDNW_fab[0]);
+            bdy_time_interval = wrfbdy_stream->time_interval();
+            wrfbdy_stream->update(t_new[lev], bdy_data_xlo, bdy_data_xhi, bdy_data_ylo, bdy_data_yhi);
+        } else {
+            bdy_time_interval = read_from_wrfbdy(nc_bdy_file,geom[0].Domain(),bdy_data_xlo,bdy_data_xhi,bdy_data_ylo,bdy_data_yhi);
+
+            const Box& domain = geom[lev].Domain();
+
+            convert_wrfbdy_data(0,domain,bdy_data_xlo,
+                                NC_MUB_fab[0], NC_MSFU_fab[0], NC_MSFV_fab[0], NC_MSFM_fab[0],
+                                NC_PH_fab[0] , NC_PHB_fab[0],
+                                NC_C1H_fab[0], NC_C2H_fab[0], NC_RDNW_fab[0],
+                                NC_xvel_fab[0],NC_yvel_fab[0],NC_rho_fab[0],NC_rhoth_fab[0]);
+            convert_wrfbdy_data(1,domain,bdy_data_xhi,
+                                NC_MUB_fab[0], NC_MSFU_fab[0], NC_MSFV_fab[0], NC_MSFM_fab[0],
+                                NC_PH_fab[0] , NC_PHB_fab[0],
+                                NC_C1H_fab[0], NC_C2H_fab[0], NC_RDNW_fab[0],
+                                NC_xvel_fab[0],NC_yvel_fab[0],NC_rho_fab[0],NC_rhoth_fab[0]);
+            convert_wrfbdy_data(2,domain,bdy_data_ylo,
+                                NC_MUB_fab[0], NC_MSFU_fab[0], NC_MSFV_fab[0], NC_MSFM_fab[0],
+                                NC_PH_fab[0] , NC_PHB_fab[0],
+                                NC_C1H_fab[0], NC_C2H_fab[0], NC_RDNW_fab[0],
+                                NC_xvel_fab[0],NC_yvel_fab[0],NC_rho_fab[0],NC_rhoth_fab[0]);
+            convert_wrfbdy_data(3,domain,bdy_data_yhi,
+                                NC_MUB_fab[0], NC_MSFU_fab[0], NC_MSFV_fab[0], NC_MSFM_fab[0],
+                                NC_PH_fab[0] , NC_PHB_fab[0],
+                                NC_C1H_fab[0], NC_C2H_fab[0], NC_RDNW_fab[0],
+                                NC_xvel_fab[0],NC_yvel_fab[0],NC_rho_fab[0],NC_rhoth_fab[0]);
+        } // wrfbdy_streaming
+
+        // The boundary zone can be no wider than the strips of data in the file
+        int file_width = (wrfbdy_stream) ? wrfbdy_stream->bdy_width()
+                                         : bdy_data_xlo[0][WRFBdyVars::T].box().length(0);
+        if (wrfbdy_width > file_width) {
+            amrex::Abort("erf.wrfbdy_width is " + std::to_string(wrfbdy_width) +
+                         " but the wrfbdy file only has data " + std::to_string(file_width) + " cells wide");
+        }
+
+        if (verbose > 0) {
+            // Startup cost and memory footprint of the boundary data, for comparing the two readers
+            Real bdy_time = amrex::second() - start_bdy;
+            Long bdy_bytes = 0;
+            for (const auto* bdy_data : {&bdy_data_xlo, &bdy_data_xhi, &bdy_data_ylo, &bdy_data_yhi}) {
+                for (const auto& fabs : *bdy_data) {
+                    for (const auto& fab : fabs) bdy_bytes += fab.nBytes();
+                }
+            }
+            ParallelDescriptor::ReduceRealMax(bdy_time, ParallelDescriptor::IOProcessorNumber());
+            ParallelDescriptor::ReduceLongMax(bdy_bytes, ParallelDescriptor::IOProcessorNumber());
+            amrex::Print() << "Reading the wrfbdy data took " << bdy_time << " s; at most "
+                           << bdy_bytes << " bytes of boundary data on a rank" << std::endl;
+        }
     }
 }
 
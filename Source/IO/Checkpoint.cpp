@@ -1,4 +1,5 @@
 #include <ERF.H>
+#include <Utils.H>
 #include "AMReX_PlotFileUtil.H"
 
 using namespace amrex;
@@ -122,6 +123,19 @@ ERF::WriteCheckpointFile () const
        MultiFab::Copy(base,base_state[lev],0,0,base.nComp(),0);
        VisMF::Write(cons, amrex::MultiFabFileFullPrefix(lev, checkpointname, "Level_", "BaseState"));
 
+       if (solverChoice.num_tracers > 0) {
+           MultiFab tracers(grids[lev],dmap[lev],solverChoice.num_tracers,0);
+           MultiFab::Copy(tracers,tracers_new[lev],0,0,solverChoice.num_tracers,0);
+           VisMF::Write(tracers, amrex::MultiFabFileFullPrefix(lev, checkpointname, "Level_", "Tracers"));
+       }
+
+       // The anelastic pressure perturbation is accumulated over the steps, so it must be saved
+       if (solverChoice.anelastic) {
+           MultiFab pp(grids[lev],dmap[lev],1,0);
+           MultiFab::Copy(pp,pp_inc[lev],0,0,1,0);
+           VisMF::Write(pp, amrex::MultiFabFileFullPrefix(lev, checkpointname, "Level_", "PP_Inc"));
+       }
+
        if (solverChoice.use_terrain)  {
            // Note that we write the ghost cells of z_phys_nd (unlike above)
            IntVect ngvect = z_phys_nd[lev]->nGrowVect();
@@ -248,6 +262,20 @@ ERF::ReadCheckpointFile ()
         VisMF::Read(base, amrex::MultiFabFileFullPrefix(lev, restart_chkfile, "Level_", "BaseState"));
         MultiFab::Copy(base_state[lev],base,0,0,base.nComp(),0);
 
+        if (solverChoice.num_tracers > 0) {
+            MultiFab tracers(grids[lev],dmap[lev],solverChoice.num_tracers,0);
+            VisMF::Read(tracers, amrex::MultiFabFileFullPrefix(lev, restart_chkfile, "Level_", "Tracers"));
+            MultiFab::Copy(tracers_new[lev],tracers,0,0,solverChoice.num_tracers,0);
+            FillZeroGradientGhostCells(tracers_new[lev], geom[lev]);
+        }
+
+        if (solverChoice.anelastic) {
+            MultiFab pp(grids[lev],dmap[lev],1,0);
+            VisMF::Read(pp, amrex::MultiFabFileFullPrefix(lev, restart_chkfile, "Level_", "PP_Inc"));
+            MultiFab::Copy(pp_inc[lev],pp,0,0,1,0);
+            FillZeroGradientGhostCells(pp_inc[lev], geom[lev]);
+        }
+
        if (solverChoice.use_terrain)  {
            // Note that we read the ghost cells of z_phys_nd (unlike above)
            IntVect ngvect = z_phys_nd[lev]->nGrowVect();
@@ -1,7 +1,15 @@
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include "AMReX_Gpu.H"
 #include "AMReX_ParmParse.H"
 #include <AMReX_PlotFileUtil.H>
 #include "ERF_ReadBndryPlanes.H"
+#include "ERF_BndryPlaneFile.H"
 #include "IndexDefines.H"
 #include "AMReX_MultiFabUtil.H"
 #include "EOS.H"
@@ -63,6 +71,26 @@ void ReadBndryPlanes::define_level_data(int /*lev*/)
             m_data_interp[ori]->push_back(FArrayBox(pbx, ncomp));
         }
     }
+
+    // Space for the planes as stored in the binary files, in pinned memory so that the helper
+    //    thread can fill them and the kernels that convert them can read them
+    if (m_file_format == "binary") {
+        BoxArray ba(domain);
+        DistributionMapping dm{ba};
+        BndryRegister bndry(ba, dm, m_in_rad, m_out_rad, m_extent_rad, 1);
+
+        m_raw.resize(m_var_names.size());
+        for (int ivar = 0; ivar < m_var_names.size(); ivar++) {
+            int ncomp_var = (m_var_names[ivar] == "velocity") ? AMREX_SPACEDIM : 1;
+            m_raw[ivar].resize(2*AMREX_SPACEDIM);
+            for (OrientationIter oit; oit != nullptr; ++oit) {
+                auto ori = oit();
+                if (ori.coordDir() < 2) {
+                    m_raw[ivar][ori].resize(bndry[ori].boxArray()[0], ncomp_var, The_Pinned_Arena());
+                }
+            }
+        }
+    }
 }
 
 Vector<std::unique_ptr<PlaneVector>>&
@@ -162,6 +190,15 @@ ReadBndryPlanes::ReadBndryPlanes(const Geometry& geom, const Real& rdOcp_in)
         }
     }
 
+    // Is each time a BndryRegister per variable and face, or a single binary file?
+    pp.query("bndry_file_format", m_file_format);
+    if (m_file_format != "native" && m_file_format != "binary") {
+        Error("erf.bndry_file_format must be native or binary");
+    }
+
+    // Read the next binary file on a helper thread while the current ones are in use?
+    pp.query("bndry_input_prefetch", m_prefetch);
+
     // time.dat will be in the same folder as the time series of data
     m_time_file = m_filename + "/time.dat";
 
@@ -174,6 +211,11 @@ ReadBndryPlanes::ReadBndryPlanes(const Geometry& geom, const Real& rdOcp_in)
     m_data_interp.resize(size);
 }
 
+ReadBndryPlanes::~ReadBndryPlanes()
+{
+    wait_for_prefetch();
+}
+
 void ReadBndryPlanes::read_time_file()
 {
     BL_PROFILE("ERF::ReadBndryPlanes::read_time_file");
@@ -297,6 +339,13 @@ void ReadBndryPlanes::read_input_files(Real time, Real dt,
         last_file_read = new_read;
     }
 
+    // Read the file after m_tnp2 while we step through the current ones
+    const int next_read = last_file_read+1;
+    if (m_file_format == "binary" && m_prefetch &&
+        next_read < m_in_times.size() && m_raw_idx != next_read) {
+        start_prefetch(next_read);
+    }
+
     AMREX_ASSERT(time    >= m_tn && time    <= m_tnp2);
     AMREX_ASSERT(time+dt >= m_tn && time+dt <= m_tnp2);
 }
@@ -304,6 +353,10 @@ void ReadBndryPlanes::read_input_files(Real time, Real dt,
 void ReadBndryPlanes::read_file(const int idx, Vector<std::unique_ptr<PlaneVector>>& data_to_fill,
     Array<Array<Real, AMREX_SPACEDIM*2>,AMREX_SPACEDIM+NVAR> m_bc_extdir_vals)
 {
+    BL_PROFILE("ERF::ReadBndryPlanes::read_file");
+
+    Real start = amrex::second();
+
     const int t_step = m_in_timesteps[idx];
     const std::string chkname1 = m_filename + Concatenate("/bndry_output", t_step);
 
@@ -347,6 +400,21 @@ void ReadBndryPlanes::read_file(const int idx, Vector<std::unique_ptr<PlaneVecto
         }
     }
 
+    if (m_file_format == "binary") {
+        Real wait_start = amrex::second();
+        wait_for_prefetch();
+        m_step_wait_time += amrex::second() - wait_start;
+
+        // This file was not prefetched, so read it now
+        if (m_raw_idx != idx) {
+            m_raw_idx = idx;
+            const std::string err = read_binary_file(idx);
+            if (!err.empty()) {
+                Abort(err);
+            }
+        }
+    }
+
     for (int ivar = 0; ivar < m_var_names.size(); ivar++)
     {
         std::string var_name = m_var_names[ivar];
@@ -375,6 +443,24 @@ void ReadBndryPlanes::read_file(const int idx, Vector<std::unique_ptr<PlaneVecto
 
         // amrex::Print() << "Reading " << chkname1 << " for variable " << var_name << " with n_offset == " << n_offset << std::endl;
 
+        if (m_file_format == "binary") {
+            for (OrientationIter oit; oit != nullptr; ++oit) {
+                auto ori = oit();
+                if (ori.coordDir() < 2) {
+                    const FArrayBox& raw = m_raw[ivar][ori];
+                    FArrayBox& dest = (*data_to_fill[ori])[lev];
+
+                    const Box bx = dest.box() & raw.box();
+                    FArrayBox plane(bx, ncomp);
+                    convert_plane(var_name, ori, n_for_density, bx, raw.const_array(), plane.array(),
+                                  l_bc_extdir_vals_d);
+                    dest.template copy<RunOn::Device>(plane, bx, 0, bx, n_offset, ncomp);
+                    Gpu::streamSynchronize();
+                }
+            }
+            continue;
+        }
+
         BndryRegister bndry(ba, dm, m_in_rad, m_out_rad, m_extent_rad, ncomp);
         bndry.setVal(1.0e13);
 
@@ -388,9 +474,6 @@ void ReadBndryPlanes::read_file(const int idx, Vector<std::unique_ptr<PlaneVecto
             std::string facename1 = Concatenate(filename1 + '_', ori, 1);
             bndry[ori].read(facename1);
 
-            const int normal = ori.coordDir();
-            const IntVect v_offset = offset(ori.faceDir(), normal);
-
             const auto& bbx = (*data_to_fill[ori])[lev].box();
 
             // *********************************************************
@@ -404,7 +487,7 @@ void ReadBndryPlanes::read_file(const int idx, Vector<std::unique_ptr<PlaneVecto
             for (MFIter mfi(bndryMF); mfi.isValid(); ++mfi) {
 
                 const auto& vbx = mfi.validbox();
-                const auto& bndry_read_arr = bndry[ori].array(mfi);
+                const auto& bndry_read_arr = bndry[ori].const_array(mfi);
                 const auto& bndry_mf_arr   = bndryMF.array(mfi);
 
                 const auto& bx = bbx & vbx;
@@ -412,80 +495,209 @@ void ReadBndryPlanes::read_file(const int idx, Vector<std::unique_ptr<PlaneVecto
                     continue;
                 }
 
-                // We average the two cell-centered data points in the normal direction
-                //    to define a Dirichlet value on the face itself.
-
-                // This is the scalars -- they all get multiplied by rho, and in the case of
-                //   reading in temperature, we must convert to theta first
-                Real rdOcp = m_rdOcp;
-                if (n_for_density >= 0) {
-                  if (var_name == "temperature") {
-                    ParallelFor(
-                        bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-                             Real R1 =  bndry_read_arr(i, j, k, n_for_density);
-                             Real R2 =  bndry_read_arr(i+v_offset[0],j+v_offset[1],k+v_offset[2],n_for_density);
-                             Real T1 =  bndry_read_arr(i, j, k, 0);
-                             Real T2 =  bndry_read_arr(i+v_offset[0],j+v_offset[1],k+v_offset[2],0);
-                             Real Th1 = getThgivenRandT(R1,T1,rdOcp);
-                             Real Th2 = getThgivenRandT(R2,T2,rdOcp);
-                             bndry_mf_arr(i, j, k, 0) = 0.5 * (R1*Th1 + R2*Th2);
-                        });
-                  } else if (var_name == "scalar" || var_name == "qv" || var_name == "qc" ||
-                             var_name == "KE" || var_name == "QKE") {
-                    ParallelFor(
-                        bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-                             Real R1 =  bndry_read_arr(i, j, k, n_for_density);
-                             Real R2 =  bndry_read_arr(i+v_offset[0],j+v_offset[1],k+v_offset[2],n_for_density);
-                             bndry_mf_arr(i, j, k, 0) = 0.5 *
-                                  ( R1 * bndry_read_arr(i, j, k, 0) +
-                                    R2 * bndry_read_arr(i+v_offset[0],j+v_offset[1],k+v_offset[2], 0));
-                        });
-                   } else if (var_name == "density") {
-                    ParallelFor(
-                        bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-                             bndry_mf_arr(i, j, k, 0) = 0.5 *
-                                  ( bndry_read_arr(i, j, k, 0) +
-                                    bndry_read_arr(i+v_offset[0],j+v_offset[1],k+v_offset[2], 0));
-                        });
-                   }
-                } else if (!ingested_density()) {
-                  if (var_name == "temperature") {
-                    ParallelFor(
-                        bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-                             Real R1  = l_bc_extdir_vals_d[BCVars::Rho_bc_comp][ori];
-                             Real R2  = l_bc_extdir_vals_d[BCVars::Rho_bc_comp][ori];
-                             Real T1  = bndry_read_arr(i, j, k, 0);
-                             Real T2  = bndry_read_arr(i+v_offset[0],j+v_offset[1],k+v_offset[2], 0);
-                             Real Th1 = getThgivenRandT(R1,T1,rdOcp);
-                             Real Th2 = getThgivenRandT(R2,T2,rdOcp);
-                             bndry_mf_arr(i, j, k, 0) = 0.5 * (R1*Th1 + R2*Th2);
-                        });
-                  } else if (var_name == "scalar" || var_name == "qv" || var_name == "qc" ||
-                             var_name == "KE" || var_name == "QKE") {
-                      ParallelFor(
-                        bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-                             Real R1  = l_bc_extdir_vals_d[BCVars::Rho_bc_comp][ori];
-                             Real R2  = l_bc_extdir_vals_d[BCVars::Rho_bc_comp][ori];
-                             bndry_mf_arr(i, j, k, 0) = 0.5 *
-                                (R1 * bndry_read_arr(i, j, k, 0) +
-                                 R2 * bndry_read_arr(i+v_offset[0],j+v_offset[1],k+v_offset[2], 0));
-                        });
-                  }
-                }
-
-                // This is velocity
-                if (var_name == "velocity") {
-                    ParallelFor(
-                        bx, ncomp, [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) noexcept {
-                                bndry_mf_arr(i, j, k, n) = 0.5 *
-                                  (bndry_read_arr(i, j, k, n) +
-                                   bndry_read_arr(i+v_offset[0],j+v_offset[1],k+v_offset[2], n));
-                        });
-                }
+                convert_plane(var_name, ori, n_for_density, bx, bndry_read_arr, bndry_mf_arr,
+                              l_bc_extdir_vals_d);
 
             } // mfi
             bndryMF.copyTo((*data_to_fill[ori])[lev], 0, n_offset, ncomp);
           } // coordDir < 2
         } // ori
     } // var_name
+
+    m_step_reads++;
+    m_step_read_time += amrex::second() - start;
+}
+
+void ReadBndryPlanes::convert_plane(const std::string& var_name, Orientation ori, int n_for_density,
+                                    const Box& bx,
+                                    const Array4<Real const>& bndry_read_arr,
+                                    const Array4<Real>& bndry_mf_arr,
+                                    const GpuArray<GpuArray<Real, AMREX_SPACEDIM*2>,
+                                                   AMREX_SPACEDIM+NVAR>& l_bc_extdir_vals_d) const
+{
+    const int normal = ori.coordDir();
+    const IntVect v_offset = offset(ori.faceDir(), normal);
+    const int ncomp = bndry_mf_arr.nComp();
+
+    // We average the two cell-centered data points in the normal direction
+    //    to define a Dirichlet value on the face itself.
+
+    // This is the scalars -- they all get multiplied by rho, and in the case of
+    //   reading in temperature, we must convert to theta first
+    Real rdOcp = m_rdOcp;
+    if (n_for_density >= 0) {
+      if (var_name == "temperature") {
+        ParallelFor(
+            bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+                 Real R1 =  bndry_read_arr(i, j, k, n_for_density);
+                 Real R2 =  bndry_read_arr(i+v_offset[0],j+v_offset[1],k+v_offset[2],n_for_density);
+                 Real T1 =  bndry_read_arr(i, j, k, 0);
+                 Real T2 =  bndry_read_arr(i+v_offset[0],j+v_offset[1],k+v_offset[2],0);
+                 Real Th1 = getThgivenRandT(R1,T1,rdOcp);
+                 Real Th2 = getThgivenRandT(R2,T2,rdOcp);
+                 bndry_mf_arr(i, j, k, 0) = 0.5 * (R1*Th1 + R2*Th2);
+            });
+      } else if (var_name == "scalar" || var_name == "qv" || var_name == "qc" ||
+                 var_name == "KE" || var_name == "QKE") {
+        ParallelFor(
+            bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+                 Real R1 =  bndry_read_arr(i, j, k, n_for_density);
+                 Real R2 =  bndry_read_arr(i+v_offset[0],j+v_offset[1],k+v_offset[2],n_for_density);
+                 bndry_mf_arr(i, j, k, 0) = 0.5 *
+                      ( R1 * bndry_read_arr(i, j, k, 0) +
+                        R2 * bndry_read_arr(i+v_offset[0],j+v_offset[1],k+v_offset[2], 0));
+            });
+       } else if (var_name == "density") {
+        ParallelFor(
+            bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+                 bndry_mf_arr(i, j, k, 0) = 0.5 *
+                      ( bndry_read_arr(i, j, k, 0) +
+                        bndry_read_arr(i+v_offset[0],j+v_offset[1],k+v_offset[2], 0));
+            });
+       }
+    } else if (!ingested_density()) {
+      if (var_name == "temperature") {
+        ParallelFor(
+            bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+                 Real R1  = l_bc_extdir_vals_d[BCVars::Rho_bc_comp][ori];
+                 Real R2  = l_bc_extdir_vals_d[BCVars::Rho_bc_comp][ori];
+                 Real T1  = bndry_read_arr(i, j, k, 0);
+                 Real T2  = bndry_read_arr(i+v_offset[0],j+v_offset[1],k+v_offset[2], 0);
+                 Real Th1 = getThgivenRandT(R1,T1,rdOcp);
+                 Real Th2 = getThgivenRandT(R2,T2,rdOcp);
+                 bndry_mf_arr(i, j, k, 0) = 0.5 * (R1*Th1 + R2*Th2);
+            });
+      } else if (var_name == "scalar" || var_name == "qv" || var_name == "qc" ||
+                 var_name == "KE" || var_name == "QKE") {
+          ParallelFor(
+            bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+                 Real R1  = l_bc_extdir_vals_d[BCVars::Rho_bc_comp][ori];
+                 Real R2  = l_bc_extdir_vals_d[BCVars::Rho_bc_comp][ori];
+                 bndry_mf_arr(i, j, k, 0) = 0.5 *
+                    (R1 * bndry_read_arr(i, j, k, 0) +
+                     R2 * bndry_read_arr(i+v_offset[0],j+v_offset[1],k+v_offset[2], 0));
+            });
+      }
+    }
+
+    // This is velocity
+    if (var_name == "velocity") {
+        ParallelFor(
+            bx, ncomp, [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) noexcept {
+                    bndry_mf_arr(i, j, k, n) = 0.5 *
+                      (bndry_read_arr(i, j, k, n) +
+                       bndry_read_arr(i+v_offset[0],j+v_offset[1],k+v_offset[2], n));
+            });
+    }
+}
+
+std::string ReadBndryPlanes::read_binary_file(const int idx)
+{
+    const std::string fname = m_filename + Concatenate("/bndry_output", m_in_timesteps[idx]) + ".bin";
+
+    int fd = open(fname.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return "Cannot open boundary plane file: " + fname;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return "Cannot stat boundary plane file: " + fname;
+    }
+    const auto nbytes = static_cast<std::size_t>(st.st_size);
+
+    // Every rank copies all the blocks into m_raw; mapping the file only saves staging
+    //    them in a read buffer first
+    void* map = mmap(nullptr, nbytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return "Cannot map boundary plane file: " + fname;
+    }
+    const char* base = static_cast<const char*>(map);
+
+    std::string err = copy_binary_blocks(base, nbytes, fname);
+
+    munmap(map, nbytes);
+    return err;
+}
+
+std::string ReadBndryPlanes::copy_binary_blocks(const char* base, const std::size_t nbytes,
+                                                const std::string& fname)
+{
+    BndryPlaneFileHeader header;
+    if (nbytes < sizeof(header)) {
+        return "Boundary plane file is too short: " + fname;
+    }
+    std::memcpy(&header, base, sizeof(header));
+    if (std::memcmp(header.magic, bndry_plane_file_magic, sizeof(header.magic)) != 0 ||
+        header.version != bndry_plane_file_version) {
+        return "Not a boundary plane file: " + fname;
+    }
+    if (header.real_size != static_cast<int>(sizeof(Real))) {
+        return "Boundary plane file " + fname + " was written with a different precision";
+    }
+    if (header.nblocks < 0 || nbytes < sizeof(header) + header.nblocks * sizeof(BndryPlaneBlock)) {
+        return "Boundary plane file is too short: " + fname;
+    }
+
+    Vector<BndryPlaneBlock> blocks(header.nblocks);
+    std::memcpy(blocks.data(), base + sizeof(header), header.nblocks * sizeof(BndryPlaneBlock));
+
+    for (int ivar = 0; ivar < m_var_names.size(); ivar++)
+    {
+        for (OrientationIter oit; oit != nullptr; ++oit) {
+            auto ori = oit();
+            if (ori.coordDir() < 2) {
+                FArrayBox& raw = m_raw[ivar][ori];
+
+                const BndryPlaneBlock* block = nullptr;
+                for (const auto& b : blocks) {
+                    if (m_var_names[ivar] == b.var_name && b.face == static_cast<int>(ori)) {
+                        block = &b;
+                    }
+                }
+                if (block == nullptr) {
+                    return "No " + m_var_names[ivar] + " data in boundary plane file: " + fname;
+                }
+
+                // The planes were written for a box starting at (0,0,0), so only the shape must match
+                Box file_box(IntVect(AMREX_D_DECL(block->lo[0],block->lo[1],block->lo[2])),
+                             IntVect(AMREX_D_DECL(block->hi[0],block->hi[1],block->hi[2])));
+                if (block->ncomp != raw.nComp() || file_box.size() != raw.box().size()) {
+                    return "The boundary planes in " + fname + " do not match the domain of this simulation";
+                }
+
+                if (block->offset < 0 || block->offset + raw.nBytes() > nbytes) {
+                    return "Boundary plane file is too short: " + fname;
+                }
+                std::memcpy(raw.dataPtr(), base + block->offset, raw.nBytes());
+            }
+        }
+    }
+
+    return std::string();
+}
+
+void ReadBndryPlanes::start_prefetch(const int idx)
+{
+    wait_for_prefetch();
+    m_raw_idx = idx;
+    m_prefetch_future = std::async(std::launch::async, [this,idx] () { return read_binary_file(idx); });
+}
+
+void ReadBndryPlanes::wait_for_prefetch()
+{
+    if (m_prefetch_future.valid()) {
+        // The helper thread may not call MPI, so it hands its error back to abort here
+        const std::string err = m_prefetch_future.get();
+        if (!err.empty()) {
+            Abort(err);
+        }
+    }
+}
+
+void ReadBndryPlanes::print_step_stats() const
+{
+    amrex::Print() << "Boundary planes: " << m_step_reads << " files read this step in " << m_step_read_time
+                   << " s (" << m_step_wait_time << " s waiting for the prefetch)" << std::endl;
 }
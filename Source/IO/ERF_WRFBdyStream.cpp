@@ -0,0 +1,310 @@
+#include <algorithm>
+
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Print.H>
+
+#include <ERF_WRFBdyStream.H>
+#include <IndexDefines.H>
+#include <NCInterface.H>
+
+using namespace amrex;
+
+#ifdef ERF_USE_NETCDF
+
+namespace {
+    constexpr int NumFaces = 4; // WRFBdyTypes: x_lo, x_hi, y_lo, y_hi
+}
+
+WRFBdyStream::WRFBdyStream (const std::string& nc_bdy_file, const Box& domain,
+                            const BoxArray& ba, const DistributionMapping& dm, int nghost)
+    : m_fname(nc_bdy_file), m_domain(domain)
+{
+    int ioproc = ParallelDescriptor::IOProcessorNumber();  // I/O rank
+
+    // Width of the boundary region (1 <= ng <= 5)
+    int& ng = m_ng;
+    if (ParallelDescriptor::IOProcessor())
+    {
+        read_wrfbdy_times(m_fname, m_ntimes, m_time_interval);
+
+        auto ncf = ncutils::NCFile::open(m_fname, NC_CLOBBER | NC_NETCDF4);
+        ng = static_cast<int>(ncf.var(wrfbdy_var_name(WRFBdyTypes::x_lo, WRFBdyVars::U)).shape()[1]);
+        ncf.close();
+    }
+    ParallelDescriptor::Bcast(&m_ntimes,1,ioproc);
+    ParallelDescriptor::Bcast(&m_time_interval,1,ioproc);
+    ParallelDescriptor::Bcast(&ng,1,ioproc);
+
+    const int nprocs = ParallelDescriptor::NProcs();
+    const int myproc = ParallelDescriptor::MyProc();
+
+    m_src.resize(NumFaces);
+    m_dst_ba.resize(NumFaces);
+    m_dst_dm.resize(NumFaces);
+    m_region.resize(NumFaces);
+
+    for (int bt = 0; bt < NumFaces; ++bt)
+    {
+        m_src[bt].resize(WRFBdyVars::NumTypes);
+        m_dst_ba[bt].resize(WRFBdyVars::NumTypes);
+        m_dst_dm[bt].resize(WRFBdyVars::NumTypes);
+        m_region[bt].resize(WRFBdyVars::NumTypes);
+
+        for (int iv = 0; iv < WRFBdyVars::NumTypes; ++iv)
+        {
+            const Box strip = wrfbdy_box(domain, ng, bt, iv);
+
+            // The conversion reads MU next to the faces where U and V live, so the columns
+            //    of MU and PC are taken one cell further out
+            bool is_column = (iv == WRFBdyVars::MU || iv == WRFBdyVars::PC);
+            int ngrow = is_column ? nghost+2 : nghost+1;
+
+            // Bounding box of the part of the strip each rank needs (empty, but of the right type,
+            //    if none)
+            Vector<Box> need(nprocs, amrex::convert(Box(), strip.ixType()));
+            for (int i = 0; i < ba.size(); ++i) {
+                Box g = amrex::grow(ba[i], ngrow);
+                if (is_column) {
+                    g.setSmall(2,0); g.setBig(2,0);
+                }
+                Box b = amrex::convert(g, strip.ixType()) & strip;
+                if (b.ok()) {
+                    Box& n = need[dm[i]];
+                    n = n.ok() ? amrex::minBox(n, b) : b;
+                }
+            }
+
+            BoxList bl(strip.ixType());
+            Vector<int> pmap;
+            for (int p = 0; p < nprocs; ++p) {
+                if (need[p].ok()) {
+                    bl.push_back(need[p]);
+                    pmap.push_back(p);
+                }
+            }
+            m_dst_ba[bt][iv] = BoxArray(bl);
+            m_dst_dm[bt][iv] = DistributionMapping(pmap);
+            m_region[bt][iv] = need[myproc];
+
+            // R is not read, it is computed by the conversion
+            m_src[bt][iv] = std::make_unique<MultiFab>(BoxArray(strip), DistributionMapping(Vector<int>{ioproc}),
+                                                       1, 0, MFInfo().SetArena(The_Pinned_Arena()));
+            m_src[bt][iv]->setVal(0.0);
+        }
+    }
+}
+
+WRFBdyStream::~WRFBdyStream ()
+{
+    wait();
+}
+
+void
+WRFBdyStream::set_wrfinput_fields (const FArrayBox& NC_MUB_fab,
+                                   const FArrayBox& NC_PH_fab, const FArrayBox& NC_PHB_fab,
+                                   const FArrayBox& NC_C1H_fab, const FArrayBox& NC_C2H_fab,
+                                   const FArrayBox& NC_RDNW_fab)
+{
+    m_mub.resize(NumFaces);
+    m_ph.resize(NumFaces);
+    m_phb.resize(NumFaces);
+
+    for (int bt = 0; bt < NumFaces; ++bt)
+    {
+        // MUB is used where MU is
+        const Box& mu_region = m_region[bt][WRFBdyVars::MU];
+        Box mub_bx(mu_region.smallEnd(), mu_region.bigEnd(), NC_MUB_fab.box().ixType());
+        mub_bx &= NC_MUB_fab.box();
+        m_mub[bt].resize(mub_bx, 1);
+        if (mub_bx.ok()) m_mub[bt].template copy<RunOn::Device>(NC_MUB_fab, mub_bx);
+
+        // PH and PHB are used below and above the cells where T is
+        const Box& t_region = m_region[bt][WRFBdyVars::T];
+        Box ph_bx(t_region.smallEnd(), t_region.bigEnd(), NC_PH_fab.box().ixType());
+        ph_bx.growHi(2,1);
+        ph_bx &= NC_PH_fab.box();
+        m_ph[bt].resize(ph_bx, 1);
+        m_phb[bt].resize(ph_bx, 1);
+        if (ph_bx.ok()) {
+            m_ph[bt].template copy<RunOn::Device>(NC_PH_fab, ph_bx);
+            m_phb[bt].template copy<RunOn::Device>(NC_PHB_fab, ph_bx);
+        }
+    }
+
+    // These are columns, so every rank keeps all of them
+    m_c1h.resize(NC_C1H_fab.box(), 1);
+    m_c2h.resize(NC_C2H_fab.box(), 1);
+    m_rdnw.resize(NC_RDNW_fab.box(), 1);
+    m_c1h.template copy<RunOn::Device>(NC_C1H_fab);
+    m_c2h.template copy<RunOn::Device>(NC_C2H_fab);
+    m_rdnw.template copy<RunOn::Device>(NC_RDNW_fab);
+    Gpu::streamSynchronize();
+}
+
+void
+WRFBdyStream::update (Real time,
+                      Vector<Vector<FArrayBox>>& bdy_data_xlo,
+                      Vector<Vector<FArrayBox>>& bdy_data_xhi,
+                      Vector<Vector<FArrayBox>>& bdy_data_ylo,
+                      Vector<Vector<FArrayBox>>& bdy_data_yhi)
+{
+    int n_time = static_cast<int>(time / m_time_interval);
+    if (n_time == m_window) return;
+
+    if (n_time < 0 || n_time+1 >= m_ntimes) {
+        amrex::Abort("The wrfbdy file has no boundary data after time " + std::to_string(time));
+    }
+
+    // In WRFBdyTypes order
+    Vector<Vector<Vector<FArrayBox>>*> bdy_data = {&bdy_data_xlo, &bdy_data_xhi, &bdy_data_ylo, &bdy_data_yhi};
+
+    for (auto* bd : bdy_data) {
+        bd->resize(m_ntimes);
+    }
+
+    // Free the time levels we are done with
+    if (m_window >= 0) {
+        for (int nt = m_window; nt <= m_window+1; ++nt) {
+            if (nt != n_time && nt != n_time+1) {
+                for (auto* bd : bdy_data) {
+                    (*bd)[nt].clear();
+                }
+            }
+        }
+    }
+
+    for (int nt = n_time; nt <= n_time+1; ++nt) {
+        if ((*bdy_data[0])[nt].empty()) {
+            load(nt, bdy_data);
+        }
+    }
+    m_window = n_time;
+
+    Long nbytes = 0;
+    for (auto* bd : bdy_data) {
+        for (int nt = n_time; nt <= n_time+1; ++nt) {
+            for (const auto& fab : (*bd)[nt]) {
+                nbytes += fab.nBytes();
+            }
+        }
+    }
+    for (int bt = 0; bt < static_cast<int>(m_mub.size()); ++bt) {
+        nbytes += m_mub[bt].nBytes() + m_ph[bt].nBytes() + m_phb[bt].nBytes();
+    }
+    if (ParallelDescriptor::IOProcessor()) {
+        for (const auto& src_face : m_src) {
+            for (const auto& src : src_face) {
+                nbytes += (*src)[0].nBytes();
+            }
+        }
+    }
+    m_peak_nbytes = std::max(m_peak_nbytes, nbytes);
+}
+
+void
+WRFBdyStream::load (int nt, const Vector<Vector<Vector<FArrayBox>>*>& bdy_data)
+{
+    Real start = amrex::second();
+
+    wait();
+    m_step_wait_time += amrex::second() - start;
+
+    // Time level nt was not read ahead, so read it now
+    if (m_src_nt != nt) {
+        if (ParallelDescriptor::IOProcessor()) read(nt);
+        m_src_nt = nt;
+    }
+
+    for (int bt = 0; bt < NumFaces; ++bt)
+    {
+        Vector<FArrayBox>& out = (*bdy_data[bt])[nt];
+        out.resize(WRFBdyVars::NumTypes);
+
+        for (int iv = 0; iv < WRFBdyVars::NumTypes; ++iv)
+        {
+            MultiFab dst(m_dst_ba[bt][iv], m_dst_dm[bt][iv], 1, 0);
+            dst.ParallelCopy(*m_src[bt][iv]);
+
+            out[iv].resize(m_region[bt][iv], 1);
+            for (MFIter mfi(dst); mfi.isValid(); ++mfi) {
+                out[iv].template copy<RunOn::Device>(dst[mfi]);
+            }
+        }
+
+        convert_wrfbdy_data(bt, m_domain, out, false,
+                            m_mub[bt], FArrayBox(), FArrayBox(), FArrayBox(),
+                            m_ph[bt], m_phb[bt], m_c1h, m_c2h, m_rdnw,
+                            FArrayBox(), FArrayBox(), FArrayBox(), FArrayBox());
+    }
+    Gpu::streamSynchronize();
+
+    // Read the next time level while this one is in use
+    if (nt+1 < m_ntimes) {
+        m_src_nt = nt+1;
+        if (ParallelDescriptor::IOProcessor()) {
+            m_read_ahead = std::async(std::launch::async, [this,nt] () { read(nt+1); });
+        }
+    }
+
+    m_step_loads++;
+    m_step_time += amrex::second() - start;
+}
+
+void
+WRFBdyStream::read (int nt)
+{
+    auto ncf = ncutils::NCFile::open(m_fname, NC_CLOBBER | NC_NETCDF4);
+
+    for (int bt = 0; bt < NumFaces; ++bt)
+    {
+        for (int iv = 0; iv < WRFBdyVars::NumTypes; ++iv)
+        {
+            if (iv == WRFBdyVars::R) continue;
+
+            std::string vname = wrfbdy_var_name(bt, iv);
+            std::vector<size_t> shape = ncf.var(vname).shape();
+
+            // Just time level nt
+            std::vector<size_t> start(shape.size(), 0);
+            std::vector<size_t> count(shape);
+            start[0] = nt;
+            count[0] = 1;
+
+            size_t num_pts = 1;
+            for (size_t n = 1; n < shape.size(); ++n) num_pts *= shape[n];
+            std::vector<float> data(num_pts);
+
+            ncf.var(vname).get(data.data(), start, count);
+
+            copy_wrfbdy_slice((*m_src[bt][iv])[0], data.data(), shape, bt, iv);
+        }
+    }
+    ncf.close();
+}
+
+void
+WRFBdyStream::wait ()
+{
+    if (m_read_ahead.valid()) {
+        m_read_ahead.get();
+    }
+}
+
+void
+WRFBdyStream::print_step_stats () const
+{
+    int ioproc = ParallelDescriptor::IOProcessorNumber();
+
+    Real time      = m_step_time;
+    Real wait_time = m_step_wait_time;
+    ParallelDescriptor::ReduceRealMax(time, ioproc);
+    ParallelDescriptor::ReduceRealMax(wait_time, ioproc);
+
+    Long nbytes = m_peak_nbytes;
+    ParallelDescriptor::ReduceLongMax(nbytes, ioproc);
+
+    amrex::Print() << "wrfbdy: " << m_step_loads << " time levels loaded this step in " << time
+                   << " s (" << wait_time << " s waiting for the read-ahead); at most "
+                   << nbytes << " bytes of boundary data on a rank so far" << std::endl;
+}
+#endif
@@ -1,8 +1,13 @@
+#include <algorithm>
+#include <fstream>
+
 #include "AMReX_Gpu.H"
 #include "AMReX_ParmParse.H"
 #include "AMReX_PlotFileUtil.H"
 #include "AMReX_MultiFabUtil.H"
+#include "AMReX_Utility.H"
 #include "ERF_WriteBndryPlanes.H"
+#include "ERF_BndryPlaneFile.H"
 #include "IndexDefines.H"
 #include "Derive.H"
 
@@ -92,6 +97,17 @@ WriteBndryPlanes::WriteBndryPlanes(Vector<BoxArray>& grids,
         m_var_names.resize(num_vars);
         pp.queryarr("bndry_output_var_names",m_var_names,0,num_vars);
     }
+
+    // Write each time as BndryRegisters or as a single binary file?
+    pp.query("bndry_output_planes_format", m_file_format);
+    if (m_file_format != "native" && m_file_format != "binary") {
+        Error("erf.bndry_output_planes_format must be native or binary");
+    }
+    for (const auto& var_name : m_var_names) {
+        if (var_name.size() >= sizeof(BndryPlaneBlock::var_name)) {
+            Error("WriteBndryPlanes: variable name too long for the binary format: " + var_name);
+        }
+    }
 }
 
 void WriteBndryPlanes::write_planes(const int t_step, const Real time,
@@ -110,7 +126,14 @@ void WriteBndryPlanes::write_planes(const int t_step, const Real time,
     //amrex::Print() << "Writing boundary planes at time " << time << std::endl;
 
     const std::string level_prefix = "Level_";
-    PreBuildDirectorHierarchy(chkname, level_prefix, 1, true);
+    const bool write_binary = (m_file_format == "binary");
+    if (!write_binary) {
+        PreBuildDirectorHierarchy(chkname, level_prefix, 1, true);
+    }
+
+    // The blocks of the binary file, and their data, on the rank that owns the planes
+    Vector<BndryPlaneBlock> blocks;
+    Vector<FArrayBox> block_data;
 
     // note: by using the entire domain box we end up using 1 processor
     // to hold all boundaries
@@ -168,12 +191,65 @@ void WriteBndryPlanes::write_planes(const int t_step, const Real time,
             if (ori.coordDir() < 2) {
                 std::string facename = Concatenate(filename + '_', ori, 1);
                 br_shift(oit, bndry, bndry_shifted);
-                bndry_shifted[ori].write(facename);
+                if (write_binary) {
+                    for (FabSetIter bfsi(bndry_shifted[ori]); bfsi.isValid(); ++bfsi) {
+                        const FArrayBox& fab = bndry_shifted[ori][bfsi];
+
+                        BndryPlaneBlock block{};
+                        var_name.copy(block.var_name, sizeof(block.var_name)-1);
+                        block.face  = static_cast<int>(ori);
+                        block.ncomp = ncomp;
+                        for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                            block.lo[d] = fab.box().smallEnd(d);
+                            block.hi[d] = fab.box().bigEnd(d);
+                        }
+                        blocks.push_back(block);
+
+                        block_data.emplace_back(fab.box(), ncomp, The_Pinned_Arena());
+                        block_data.back().template copy<RunOn::Device>(fab);
+                    }
+                } else {
+                    bndry_shifted[ori].write(facename);
+                }
             }
         }
 
     } // loop over num_vars
 
+    if (!blocks.empty()) {
+        Gpu::streamSynchronize();
+
+        if (!UtilCreateDirectory(m_filename, 0755)) {
+            CreateDirectoryFailed(m_filename);
+        }
+
+        BndryPlaneFileHeader header{};
+        std::copy(bndry_plane_file_magic, bndry_plane_file_magic+8, header.magic);
+        header.version   = bndry_plane_file_version;
+        header.real_size = sizeof(Real);
+        header.nblocks   = static_cast<std::int32_t>(blocks.size());
+
+        std::int64_t offset = sizeof(BndryPlaneFileHeader) + blocks.size() * sizeof(BndryPlaneBlock);
+        for (int n = 0; n < blocks.size(); ++n) {
+            blocks[n].offset = offset;
+            offset += block_data[n].nBytes();
+        }
+
+        const std::string binname = chkname + ".bin";
+        std::ofstream ofs(binname, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!ofs.good()) {
+            FileOpenFailed(binname);
+        }
+        ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        ofs.write(reinterpret_cast<const char*>(blocks.data()), blocks.size() * sizeof(BndryPlaneBlock));
+        for (const auto& fab : block_data) {
+            ofs.write(reinterpret_cast<const char*>(fab.dataPtr()), fab.nBytes());
+        }
+        if (!ofs.good()) {
+            Error("WriteBndryPlanes: failed writing " + binname);
+        }
+    }
+
     // Writing time.dat
     if (ParallelDescriptor::IOProcessor()) {
         std::ofstream oftime(m_time_file, std::ios::out | std::ios::app);
@@ -12,6 +12,9 @@ ERF::WriteNCCheckpointFile () const
 
     amrex::Print() << "Writing NetCDF checkpoint " << checkpointname << "\n";
 
+    // NetCDF is not thread-safe, so the wrfbdy read-ahead must be done
+    if (wrfbdy_stream) wrfbdy_stream->wait();
+
     const int nlevels = finest_level+1;
 
     // ---- ParallelDescriptor::IOProcessor() creates the directories
@@ -55,6 +55,9 @@ ERF::writeToNCColumnFile(const int lev,
   //     partway up a column, which is the plan.
   //
 
+  // NetCDF is not thread-safe, so the wrfbdy read-ahead must be done
+  if (wrfbdy_stream) wrfbdy_stream->wait();
+
   // All processors: look for the requested column and get data if it's there
   amrex::Box probBox = geom[lev].Domain();
   const size_t nheights = probBox.length(2) + 2;
@@ -24,6 +24,9 @@ ERF::writeNCPlotFile(int lev, int which_subdomain, const std::string& dir,
                      const Vector<std::string> &plot_var_names,
                      const Vector<int> level_steps, const Real time) const
 {
+     // NetCDF is not thread-safe, so the wrfbdy read-ahead must be done
+     if (wrfbdy_stream) wrfbdy_stream->wait();
+
      // get the processor number
      int iproc = amrex::ParallelContext::MyProcAll();
      int nproc = amrex::ParallelDescriptor::NProcs();
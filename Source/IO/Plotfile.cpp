@@ -60,8 +60,17 @@ ERF::setPlotVariables (const std::string& pp_plot_var_names, Vector<std::string>
         }
     }
 
+    // "tracers" stands for the mixing ratios of all the passive tracers
+    bool plot_tracers = containerHasElement(plot_var_names, "tracers") && (solverChoice.num_tracers > 0);
+    if (plot_tracers) {
+        for (int n = 0; n < solverChoice.num_tracers; ++n) {
+            tmp_plot_names.push_back("tracer_" + std::to_string(n));
+        }
+    }
+
     // Check to see if we found all the requested variables
     for (auto plot_name : plot_var_names) {
+      if (plot_tracers && plot_name == "tracers") continue;
       if (!containerHasElement(tmp_plot_names, plot_name)) {
            Warning("\nWARNING: Requested to plot variable '" + plot_name + "' but it is not available");
       }
@@ -617,6 +626,7 @@ ERF::WritePlotFile (int which, Vector<std::string> plot_var_names)
                     zvel_arr(i,j,k) += Ampl * omega * fac * std::cos(kp * x - omega_t);
                 });
             }
+            fill_tracker.touch(vars_new[lev]);
         } // end xvel_err, yvel_err, zvel_err
 
         if (containerHasElement(plot_var_names, "pp_err"))
@@ -664,6 +674,16 @@ ERF::WritePlotFile (int which, Vector<std::string> plot_var_names)
             mf_comp += 1;
         }
 #endif
+
+        // The mixing ratios of the passive tracers come last, see setPlotVariables
+        if (containerHasElement(plot_var_names, "tracer_0")) {
+            const int ntracers = solverChoice.num_tracers;
+            for (int n = 0; n < ntracers; ++n) {
+                MultiFab::Copy(mf[lev],tracers_new[lev],n,mf_comp+n,1,0);
+                MultiFab::Divide(mf[lev],vars_new[lev][Vars::cons],Rho_comp,mf_comp+n,1,0);
+            }
+            mf_comp += ntracers;
+        }
     }
 
 
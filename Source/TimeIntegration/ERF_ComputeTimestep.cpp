@@ -20,6 +20,9 @@ ERF::ComputeDt ()
     int n_factor = 1;
     for (int lev = 0; lev <= finest_level; ++lev) {
         dt_tmp[lev] = amrex::min(dt_tmp[lev], change_max*dt[lev]);
+        if (adaptive_dt && dt_adapt_next > 0.0) {
+            dt_tmp[lev] = amrex::min(dt_tmp[lev], dt_adapt_next);
+        }
         n_factor *= nsubsteps[lev];
         dt_0 = amrex::min(dt_0, n_factor*dt_tmp[lev]);
     }
@@ -46,6 +49,10 @@ ERF::estTimeStep(int level, long& dt_fast_ratio) const
 
   auto const dxinv = geom[level].InvCellSizeArray();
 
+  // With HEVI the vertical acoustic terms are implicit so only the
+  //    horizontal sound speed limits the time step
+  const bool l_vert_implicit = (no_substepping == 2);
+
   MultiFab const& S_new = vars_new[level][Vars::cons];
 
   MultiFab ccvel(grids[level],dmap[level],3,0);
@@ -68,10 +75,11 @@ ERF::estTimeStep(int level, long& dt_fast_ratio) const
 
                amrex::Real pressure = getPgivenRTh(rhotheta);
                amrex::Real c = std::sqrt(Gamma * pressure / rho);
+               amrex::Real c_z = l_vert_implicit ? 0.0 : c;
 
-               new_comp_dt = amrex::max(((amrex::Math::abs(u(i,j,k,0))+c)*dxinv[0]),
-                                        ((amrex::Math::abs(u(i,j,k,1))+c)*dxinv[1]),
-                                        ((amrex::Math::abs(u(i,j,k,2))+c)*dxinv[2]), new_comp_dt);
+               new_comp_dt = amrex::max(((amrex::Math::abs(u(i,j,k,0))+c  )*dxinv[0]),
+                                        ((amrex::Math::abs(u(i,j,k,1))+c  )*dxinv[1]),
+                                        ((amrex::Math::abs(u(i,j,k,2))+c_z)*dxinv[2]), new_comp_dt);
            });
            return new_comp_dt;
        });
@@ -139,10 +147,95 @@ ERF::estTimeStep(int level, long& dt_fast_ratio) const
   if (fixed_dt > 0.0) {
     return fixed_dt;
   } else {
-    if (use_lowM_dt) {
+    // There are no acoustic modes in the anelastic system
+    if (use_lowM_dt || solverChoice.anelastic) {
         return estdt_lowM;
     } else {
         return estdt_comp;
     }
   }
 }
+
+// Largest stable acoustic substep for the stage data S_data (cons, xmom, ymom, zmom).
+// The vertical acoustic terms are treated implicitly in the substep, so only the
+// horizontal sound speed and the vertical advective speed enter the estimate.
+Real
+ERF::estFastTimeStep (int level, const Vector<MultiFab>& S_data) const
+{
+  BL_PROFILE("ERF::estFastTimeStep()");
+
+  auto const dxinv = geom[level].InvCellSizeArray();
+
+  MultiFab const& S_cons = S_data[IntVar::cons];
+
+  // Called every stage, so take the scratch space from the level's pool
+  ERFWorkspace& ws = *workspace[level];
+  MultiFab& ccmom = ws.acquire(S_cons.boxArray(),S_cons.DistributionMap(),3,0);
+
+  average_face_to_cellcenter(ccmom,0,
+      Array<const MultiFab*,3>{&S_data[IntVar::xmom],
+                               &S_data[IntVar::ymom],
+                               &S_data[IntVar::zmom]});
+
+  Real estdt_fast_inv = amrex::ReduceMax(S_cons, ccmom, 0,
+       [=] AMREX_GPU_HOST_DEVICE (Box const& b,
+                                  Array4<Real const> const& s,
+                                  Array4<Real const> const& m) -> Real
+       {
+           Real new_fast_dt = -1.e100;
+           amrex::Loop(b, [=,&new_fast_dt] (int i, int j, int k) noexcept
+           {
+               const amrex::Real rho      = s(i, j, k, Rho_comp);
+               const amrex::Real rhotheta = s(i, j, k, RhoTheta_comp);
+
+               amrex::Real pressure = getPgivenRTh(rhotheta);
+               amrex::Real c = std::sqrt(Gamma * pressure / rho);
+
+               new_fast_dt = amrex::max(((amrex::Math::abs(m(i,j,k,0)/rho)+c)*dxinv[0]),
+                                        ((amrex::Math::abs(m(i,j,k,1)/rho)+c)*dxinv[1]),
+                                        ((amrex::Math::abs(m(i,j,k,2)/rho)  )*dxinv[2]), new_fast_dt);
+           });
+           return new_fast_dt;
+       });
+
+   ws.release(ccmom);
+
+   amrex::ParallelDescriptor::ReduceRealMax(estdt_fast_inv);
+
+   return cfl / estdt_fast_inv;
+}
+
+// Accept or reject the step just taken at level lev based on the error estimate of
+// the MRI integrator. Returns true if the step was accepted; in either case dt is
+// set to the value suggested by the controller (for the retry or the next step).
+bool
+ERF::AdaptDt (int lev)
+{
+    const Real err = mri_integrator_mem[lev]->get_error_estimate();
+
+    // The embedded solution is first order, so the error scales like dt^2
+    Real fac = (err > 0.0) ? adaptive_dt_safety / std::sqrt(err) : change_max;
+    fac = amrex::min(change_max, amrex::max(0.2, fac));
+
+    const bool accepted = (err <= 1.0);
+
+    if (verbose) {
+        amrex::Print() << "[Level " << lev << " step " << istep[lev]+1 << "] "
+                       << (accepted ? "Accepted" : "Rejected") << " dt = " << dt[lev]
+                       << " with scaled error " << err << "; substeps per stage:";
+        for (int nrk = 0; nrk < mri_integrator_mem[lev]->num_stages(); ++nrk) {
+            amrex::Print() << " " << mri_integrator_mem[lev]->get_nsubsteps(nrk);
+        }
+        amrex::Print() << std::endl;
+    }
+
+    if (accepted) {
+        ++num_steps_accepted;
+        dt_adapt_next = fac * dt[lev];
+    } else {
+        ++num_steps_rejected;
+        dt[lev] *= fac;
+    }
+
+    return accepted;
+}
@@ -0,0 +1,163 @@
+#include <AMReX_MLMG.H>
+#include <AMReX_MLPoisson.H>
+#include <ERF.H>
+#include <Utils.H>
+
+using namespace amrex;
+
+/**
+ * Project the momenta in S_data onto div(rho u) = 0 (anelastic constraint)
+ *
+ * With rho held at its initial value the momentum equation reads d(rho u)/dt = -grad p' + ...,
+ * so the correction solves the constant coefficient Poisson equation
+ *
+ *     lap(phi) = div(rho u*),      rho u = rho u* - grad(phi)
+ *
+ * with phi = dt * (the change in p'). The slow RHS already includes -grad(pp_inc), so pp_inc is
+ * incremented by phi / dt (if dt > 0).
+ *
+ * The normal momentum is prescribed at walls, MOST, symmetry and inflow boundaries: there the
+ * correction is homogeneous Neumann. The normal flux through walls and symmetry planes is zero so the
+ * boundary face does not enter the divergence, while the inflow mass flux does. At outflow
+ * boundaries phi = 0.
+ */
+void
+ERF::project_momenta (int lev, Real l_dt, Vector<MultiFab>& S_data)
+{
+    BL_PROFILE("ERF::project_momenta()");
+    AMREX_ALWAYS_ASSERT(lev == 0);
+
+    const Geometry& l_geom = geom[lev];
+    const Box& domain = l_geom.Domain();
+    const auto dom_lo = lbound(domain);
+    const auto dom_hi = ubound(domain);
+    const GpuArray<Real, AMREX_SPACEDIM> dxInv = l_geom.InvCellSizeArray();
+
+    const BoxArray& ba            = S_data[IntVar::cons].boxArray();
+    const DistributionMapping& dm = S_data[IntVar::cons].DistributionMap();
+
+    Array<LinOpBCType,AMREX_SPACEDIM> bc_lo;
+    Array<LinOpBCType,AMREX_SPACEDIM> bc_hi;
+    GpuArray<int,AMREX_SPACEDIM> no_flux_lo;
+    GpuArray<int,AMREX_SPACEDIM> no_flux_hi;
+    for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+        if (l_geom.isPeriodic(dir)) {
+            bc_lo[dir] = LinOpBCType::Periodic;
+            bc_hi[dir] = LinOpBCType::Periodic;
+            no_flux_lo[dir] = 0;
+            no_flux_hi[dir] = 0;
+        } else {
+            const ERF_BC bc_type_lo = phys_bc_type[Orientation(dir,Orientation::low )];
+            const ERF_BC bc_type_hi = phys_bc_type[Orientation(dir,Orientation::high)];
+            bc_lo[dir] = (bc_type_lo == ERF_BC::outflow) ? LinOpBCType::Dirichlet : LinOpBCType::Neumann;
+            bc_hi[dir] = (bc_type_hi == ERF_BC::outflow) ? LinOpBCType::Dirichlet : LinOpBCType::Neumann;
+            no_flux_lo[dir] = (bc_type_lo != ERF_BC::outflow && bc_type_lo != ERF_BC::inflow);
+            no_flux_hi[dir] = (bc_type_hi != ERF_BC::outflow && bc_type_hi != ERF_BC::inflow);
+        }
+    }
+
+    // ****************************************************************************
+    // RHS: div(rho u*) over the valid cells
+    // ****************************************************************************
+    MultiFab rhs(ba, dm, 1, 0);
+    MultiFab phi(ba, dm, 1, 1);
+    phi.setVal(0.0);
+
+#ifdef _OPENMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(rhs,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox();
+
+        const Array4<Real>& rhs_arr = rhs.array(mfi);
+
+        const Array4<const Real>& rho_u = S_data[IntVar::xmom].const_array(mfi);
+        const Array4<const Real>& rho_v = S_data[IntVar::ymom].const_array(mfi);
+        const Array4<const Real>& rho_w = S_data[IntVar::zmom].const_array(mfi);
+
+        amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            Real fx_lo = (no_flux_lo[0] && i == dom_lo.x) ? 0.0 : rho_u(i  ,j,k);
+            Real fx_hi = (no_flux_hi[0] && i == dom_hi.x) ? 0.0 : rho_u(i+1,j,k);
+            Real fy_lo = (no_flux_lo[1] && j == dom_lo.y) ? 0.0 : rho_v(i,j  ,k);
+            Real fy_hi = (no_flux_hi[1] && j == dom_hi.y) ? 0.0 : rho_v(i,j+1,k);
+            Real fz_lo = (no_flux_lo[2] && k == dom_lo.z) ? 0.0 : rho_w(i,j,k  );
+            Real fz_hi = (no_flux_hi[2] && k == dom_hi.z) ? 0.0 : rho_w(i,j,k+1);
+
+            rhs_arr(i,j,k) = (fx_hi - fx_lo) * dxInv[0]
+                           + (fy_hi - fy_lo) * dxInv[1]
+                           + (fz_hi - fz_lo) * dxInv[2];
+        });
+    } // mfi
+
+    // ****************************************************************************
+    // Solve lap(phi) = div(rho u*)
+    // ****************************************************************************
+    MLPoisson mlpoisson({l_geom}, {ba}, {dm});
+    mlpoisson.setDomainBC(bc_lo, bc_hi);
+    mlpoisson.setLevelBC(0, nullptr);
+
+    MLMG mlmg(mlpoisson);
+    mlmg.setVerbose(verbose > 1 ? verbose : 0);
+    mlmg.solve({&phi}, {&rhs}, solverChoice.poisson_reltol, solverChoice.poisson_abstol);
+
+    // ****************************************************************************
+    // rho u = rho u* - grad(phi)
+    // ****************************************************************************
+    Array<MultiFab,AMREX_SPACEDIM> grad_phi;
+    for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+        grad_phi[dir].define(convert(ba, IntVect::TheDimensionVector(dir)), dm, 1, 0);
+    }
+    mlmg.getGradSolution({GetArrOfPtrs(grad_phi)});
+
+    MultiFab::Subtract(S_data[IntVar::xmom], grad_phi[0], 0, 0, 1, 0);
+    MultiFab::Subtract(S_data[IntVar::ymom], grad_phi[1], 0, 0, 1, 0);
+    MultiFab::Subtract(S_data[IntVar::zmom], grad_phi[2], 0, 0, 1, 0);
+
+    if (l_dt <= 0.0) return;
+
+    // ****************************************************************************
+    // p' += phi / dt, with zero-gradient ghost cells outside the non-periodic domain
+    // ****************************************************************************
+    MultiFab& pp = pp_inc[lev];
+    MultiFab::Saxpy(pp, 1.0/l_dt, phi, 0, 0, 1, 0);
+    FillZeroGradientGhostCells(pp, l_geom);
+}
+
+/**
+ * Project the initial velocities at level lev onto div(rho u) = 0 and refill the ghost cells
+ */
+void
+ERF::project_initial_velocities (int lev)
+{
+    BL_PROFILE("ERF::project_initial_velocities()");
+
+    auto& lev_new = vars_new[lev];
+
+    const BoxArray& ba            = lev_new[Vars::cons].boxArray();
+    const DistributionMapping& dm = lev_new[Vars::cons].DistributionMap();
+
+    Vector<MultiFab> S_data;
+    S_data.push_back(MultiFab(lev_new[Vars::cons], amrex::make_alias, 0, 1));
+    S_data.push_back(MultiFab(convert(ba, IntVect(1,0,0)), dm, 1, 0));
+    S_data.push_back(MultiFab(convert(ba, IntVect(0,1,0)), dm, 1, 0));
+    S_data.push_back(MultiFab(convert(ba, IntVect(0,0,1)), dm, 1, 0));
+
+    VelocityToMomentum(lev_new[Vars::xvel], IntVect(0),
+                       lev_new[Vars::yvel], IntVect(0),
+                       lev_new[Vars::zvel], IntVect(0),
+                       lev_new[Vars::cons],
+                       S_data[IntVar::xmom], S_data[IntVar::ymom], S_data[IntVar::zmom]);
+
+    project_momenta(lev, 0.0, S_data);
+
+    MomentumToVelocity(grids_to_evolve[lev],
+                       lev_new[Vars::xvel], lev_new[Vars::yvel], lev_new[Vars::zvel],
+                       lev_new[Vars::cons],
+                       S_data[IntVar::xmom], S_data[IntVar::ymom], S_data[IntVar::zmom]);
+    fill_tracker.touch(lev_new);
+
+    FillPatch(lev, t_new[lev],
+              {&lev_new[Vars::cons],&lev_new[Vars::xvel],&lev_new[Vars::yvel],&lev_new[Vars::zvel]});
+}
@@ -53,9 +53,51 @@ ERF::timeStep (int lev, Real time, int iteration)
                        << " with dt = " << dt[lev] << std::endl;
     }
 
+    // With error control the step may be redone, so keep a copy of the data that
+    //    Advance updates in place rather than swapping old and new
+    Vector<std::unique_ptr<MultiFab>> saved;
+    Vector<MultiFab*> in_place;
+    if (adaptive_dt)
+    {
+#ifdef ERF_USE_MOISTURE
+        in_place.push_back(&qv[lev]);
+        in_place.push_back(&qc[lev]);
+        in_place.push_back(&qi[lev]);
+#endif
+        if (solverChoice.anelastic) in_place.push_back(&pp_inc[lev]);
+
+        for (auto* mf : in_place) {
+            saved.push_back(std::make_unique<MultiFab>(mf->boxArray(), mf->DistributionMap(),
+                                                       mf->nComp(), mf->nGrowVect()));
+            MultiFab::Copy(*saved.back(), *mf, 0, 0, mf->nComp(), mf->nGrowVect());
+        }
+    }
+
     // Advance a single level for a single time step
     Advance(lev, time, dt[lev], iteration, nsubsteps[lev]);
 
+    // With error control, redo the step with the reduced dt until it is accepted
+    if (adaptive_dt)
+    {
+        int nretry = 0;
+        while (!AdaptDt(lev))
+        {
+            if (++nretry > adaptive_dt_max_retries) {
+                amrex::Abort("ERF::timeStep: too many rejected steps with erf.adaptive_dt");
+            }
+
+            // Advance swaps old and new, so swap back to restore the state at t_old
+            std::swap(vars_old[lev], vars_new[lev]);
+            if (solverChoice.num_tracers > 0) std::swap(tracers_old[lev], tracers_new[lev]);
+            for (int n = 0; n < in_place.size(); ++n) {
+                MultiFab::Copy(*in_place[n], *saved[n], 0, 0, saved[n]->nComp(), saved[n]->nGrowVect());
+            }
+            t_new[lev] = t_old[lev] + dt[lev];
+
+            Advance(lev, time, dt[lev], iteration, nsubsteps[lev]);
+        }
+    }
+
     ++istep[lev];
 
     if (Verbose())
@@ -84,6 +126,10 @@ ERF::Advance (int lev, Real time, Real dt_lev, int /*iteration*/, int /*ncycle*/
 
     // We must swap the pointers so the previous step's "new" is now this step's "old"
     std::swap(vars_old[lev], vars_new[lev]);
+    if (solverChoice.num_tracers > 0) std::swap(tracers_old[lev], tracers_new[lev]);
+
+    // Everything in "new" is about to be overwritten
+    fill_tracker.touch(vars_new[lev]);
 
     MultiFab& S_old = vars_old[lev][Vars::cons];
     MultiFab& S_new = vars_new[lev][Vars::cons];
@@ -0,0 +1,173 @@
+#include <ERF.H>
+#include <Advection.H>
+#include <Utils.H>
+
+using namespace amrex;
+
+/**
+ * Initialize every passive tracer at level lev with the advected scalar, i.e. rho times its
+ * mixing ratio, and fill the ghost cells
+ */
+void
+ERF::init_tracers (int lev)
+{
+    BL_PROFILE("ERF::init_tracers()");
+
+    MultiFab& tr = tracers_new[lev];
+    const MultiFab& cons = vars_new[lev][Vars::cons];
+
+    for (int n = 0; n < tr.nComp(); ++n) {
+        MultiFab::Copy(tr, cons, RhoScalar_comp, n, 1, 0);
+    }
+    FillZeroGradientGhostCells(tr, geom[lev]);
+}
+
+/**
+ * Advance the passive tracers over one RK stage of the slow integrator
+ *
+ *     tr_out = tr_old - dt * div(avg_mom * tr_stage / rho_stage)
+ *
+ * with the same time averaged momenta as the scalars in erf_slow_rhs_post. The tracers are
+ * neither diffused nor forced; the ghost cells are filled by extrapolation outside the domain.
+ *
+ * @param[in]  lev        level of refinement
+ * @param[in]  dt         slow time step of this stage
+ * @param[in]  tr_old     tracers at the start of the time step
+ * @param[in]  tr_stage   tracers at the start of this stage
+ * @param[out] tr_out     tracers at the end of this stage
+ * @param[in]  cons_stage conserved variables at the start of this stage
+ * @param[in]  avg_mom    momenta averaged over the fast substeps
+ */
+void
+ERF::advance_tracers (int lev, Real dt,
+                      const MultiFab& tr_old, const MultiFab& tr_stage, MultiFab& tr_out,
+                      const MultiFab& cons_stage, const Vector<MultiFab>& avg_mom)
+{
+    BL_PROFILE("ERF::advance_tracers()");
+
+    AMREX_ASSERT(&tr_out != &tr_stage);
+
+    const int ntracers = tr_out.nComp();
+    const bool l_use_terrain = solverChoice.use_terrain;
+    const GpuArray<Real, AMREX_SPACEDIM> dxInv = geom[lev].InvCellSizeArray();
+
+    const AdvectionSrcForTracersFn advection_tracers = select_advection_kernels(solverChoice).tracers;
+
+#ifdef _OPENMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(tr_out,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox();
+
+        const Array4<const Real>& avg_xmom = avg_mom[IntVar::xmom].const_array(mfi);
+        const Array4<const Real>& avg_ymom = avg_mom[IntVar::ymom].const_array(mfi);
+        const Array4<const Real>& avg_zmom = avg_mom[IntVar::zmom].const_array(mfi);
+
+        const Array4<const Real>& detJ = l_use_terrain ? detJ_cc[lev]->const_array(mfi) : Array4<const Real>{};
+        const Array4<const Real>& mf_m = mapfac_m[lev]->const_array(mfi);
+
+        advection_tracers(bx, ntracers, dt, avg_xmom, avg_ymom, avg_zmom,
+                          cons_stage.const_array(mfi), tr_old.const_array(mfi),
+                          tr_stage.const_array(mfi), tr_out.array(mfi),
+                          detJ, dxInv, mf_m);
+    } // mfi
+
+    FillZeroGradientGhostCells(tr_out, geom[lev]);
+}
+
+/**
+ * Advance the passive tracers over a whole time step with the flux-form semi-Lagrangian scheme
+ *
+ * The three directions are swept one after the other, alternating the order from step to step.
+ * Every sweep updates the tracers and, with the same mass fluxes, a copy of the density, so that
+ * the density seen by the last sweep is the density at the end of the step.
+ *
+ * @param[in]  lev      level of refinement
+ * @param[in]  dt       time step
+ * @param[in]  tr_old   tracers at the start of the time step
+ * @param[out] tr_new   tracers at the end of the time step
+ * @param[in]  cons_old conserved variables at the start of the time step
+ * @param[in]  avg_mom  momenta averaged over the (last stage of the) time step
+ */
+void
+ERF::advance_tracers_sl (int lev, Real dt,
+                         const MultiFab& tr_old, MultiFab& tr_new,
+                         const MultiFab& cons_old, const Vector<MultiFab>& avg_mom)
+{
+    BL_PROFILE("ERF::advance_tracers_sl()");
+
+    const int ntracers  = tr_new.nComp();
+    const int max_cells = solverChoice.tracer_max_courant;
+    const IntVect ngrow = tr_new.nGrowVect();
+    const GpuArray<Real, AMREX_SPACEDIM> dx    = geom[lev].CellSizeArray();
+    const GpuArray<Real, AMREX_SPACEDIM> dxInv = geom[lev].InvCellSizeArray();
+
+    const BoxArray& ba            = tr_new.boxArray();
+    const DistributionMapping& dm = tr_new.DistributionMap();
+
+    ERFWorkspace& ws = *workspace[lev];
+
+    MultiFab& rho = ws.acquire(ba, dm, 1, ngrow);
+    MultiFab::Copy(rho, cons_old, Rho_comp, 0, 1, 0);
+    FillZeroGradientGhostCells(rho, geom[lev]);
+
+    MultiFab::Copy(tr_new, tr_old, 0, 0, ntracers, ngrow);
+
+    // The swept mass may not reach beyond the ghost cells: check with the smallest density
+    const Real rho_min = rho.min(0);
+    for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+        const Real courant = avg_mom[dir].norm0() * dt * dxInv[dir] / rho_min;
+        if (courant > Real(max_cells)) {
+            amrex::Abort("ERF::advance_tracers_sl: Courant number " + std::to_string(courant) +
+                         " exceeds erf.tracer_max_courant");
+        }
+    }
+
+    for (int d = 0; d < AMREX_SPACEDIM; ++d)
+    {
+        const int dir = (istep[lev] % 2 == 0) ? d : AMREX_SPACEDIM-1-d;
+        const IntVect e = IntVect::TheDimensionVector(dir);
+
+        MultiFab& flux = ws.acquire(convert(ba, e), dm, ntracers, IntVect(0));
+
+#ifdef _OPENMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(tr_new,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            const Box& fbx = mfi.nodaltilebox(dir);
+            SemiLagrangianTracerFlux(fbx, dir, ntracers, max_cells, dt, dx[dir],
+                                     avg_mom[dir].const_array(mfi), rho.const_array(mfi),
+                                     tr_new.const_array(mfi), flux.array(mfi));
+        }
+
+#ifdef _OPENMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(tr_new,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.tilebox();
+            const Array4<      Real>& tr_arr  = tr_new.array(mfi);
+            const Array4<      Real>& rho_arr = rho.array(mfi);
+            const Array4<const Real>& f_arr   = flux.const_array(mfi);
+            const Array4<const Real>& mom_arr = avg_mom[dir].const_array(mfi);
+            const Real fac = dxInv[dir];
+
+            amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                rho_arr(i,j,k) -= dt * fac * (mom_arr(i+e[0],j+e[1],k+e[2]) - mom_arr(i,j,k));
+                for (int n = 0; n < ntracers; ++n) {
+                    tr_arr(i,j,k,n) -= fac * (f_arr(i+e[0],j+e[1],k+e[2],n) - f_arr(i,j,k,n));
+                }
+            });
+        }
+
+        ws.release(flux);
+
+        FillZeroGradientGhostCells(tr_new, geom[lev]);
+        FillZeroGradientGhostCells(rho   , geom[lev]);
+    }
+
+    ws.release(rho);
+}
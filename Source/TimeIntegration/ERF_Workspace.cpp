@@ -0,0 +1,121 @@
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Print.H>
+#include <ERF_Workspace.H>
+
+using namespace amrex;
+
+template <class MF>
+MF&
+ERFWorkspace::acquire_slot (Vector<Slot<MF> >& slots, const BoxArray& ba, const DistributionMapping& dm,
+                            int ncomp, const IntVect& ngrow)
+{
+    for (auto& s : slots) {
+        if (!s.in_use && s.mf->nComp() == ncomp && s.mf->nGrowVect() == ngrow &&
+            s.mf->boxArray() == ba && s.mf->DistributionMap() == dm)
+        {
+            s.in_use = true;
+            ++m_step_reuses;
+            return *s.mf;
+        }
+    }
+
+    Slot<MF> s;
+    s.mf = std::make_unique<MF>(ba, dm, ncomp, ngrow);
+    for (MFIter mfi(*s.mf); mfi.isValid(); ++mfi) {
+        s.nbytes += (*s.mf)[mfi].nBytes();
+    }
+    s.in_use = true;
+
+    ++m_step_allocs;
+    m_step_bytes += s.nbytes;
+    m_held_bytes += s.nbytes;
+
+    slots.push_back(std::move(s));
+    return *slots.back().mf;
+}
+
+template <class MF>
+bool
+ERFWorkspace::release_slot (Vector<Slot<MF> >& slots, const MF* mf)
+{
+    for (auto& s : slots) {
+        if (s.mf.get() == mf) {
+            AMREX_ASSERT(s.in_use);
+            s.in_use = false;
+            return true;
+        }
+    }
+    return false;
+}
+
+MultiFab&
+ERFWorkspace::acquire (const BoxArray& ba, const DistributionMapping& dm,
+                       int ncomp, const IntVect& ngrow)
+{
+    return acquire_slot(m_slots, ba, dm, ncomp, ngrow);
+}
+
+void
+ERFWorkspace::release (const MultiFab* mf)
+{
+    if (mf == nullptr) return;
+
+    if (!release_slot(m_slots, mf)) {
+        amrex::Abort("ERFWorkspace::release: MultiFab was not acquired from this workspace");
+    }
+}
+
+#ifdef ERF_MIXED_PRECISION_FAST
+FastMultiFab&
+ERFWorkspace::acquire_fast (const BoxArray& ba, const DistributionMapping& dm,
+                            int ncomp, const IntVect& ngrow)
+{
+    return acquire_slot(m_fast_slots, ba, dm, ncomp, ngrow);
+}
+
+void
+ERFWorkspace::release (const FastMultiFab* mf)
+{
+    if (mf == nullptr) return;
+
+    if (!release_slot(m_fast_slots, mf)) {
+        amrex::Abort("ERFWorkspace::release: FabArray was not acquired from this workspace");
+    }
+}
+#endif
+
+void
+ERFWorkspace::clear ()
+{
+    for (const auto& s : m_slots) {
+        AMREX_ALWAYS_ASSERT(!s.in_use);
+    }
+    for (const auto& s : m_fast_slots) {
+        AMREX_ALWAYS_ASSERT(!s.in_use);
+    }
+    m_slots.clear();
+    m_fast_slots.clear();
+    m_held_bytes = 0;
+}
+
+void
+ERFWorkspace::reset_step_stats ()
+{
+    m_step_allocs = 0;
+    m_step_reuses = 0;
+    m_step_bytes  = 0;
+}
+
+void
+ERFWorkspace::print_step_stats (int lev) const
+{
+    Long step_bytes = m_step_bytes;
+    Long held_bytes = m_held_bytes;
+    ParallelDescriptor::ReduceLongSum(step_bytes);
+    ParallelDescriptor::ReduceLongSum(held_bytes);
+
+    amrex::Print() << "Workspace at level " << lev << ": "
+                   << m_step_allocs << " allocations (" << step_bytes << " bytes) and "
+                   << m_step_reuses << " reuses this step; "
+                   << num_buffers() << " buffers (" << held_bytes << " bytes) held" << std::endl;
+}
@@ -8,6 +8,7 @@
 #include <IndexDefines.H>
 #include <TerrainMetrics.H>
 #include <TimeIntegration.H>
+#include <ERF_TridiagonalSolve.H>
 #include <prob_common.H>
 
 using namespace amrex;
@@ -19,11 +20,12 @@ void erf_fast_rhs_MT (int step, int /*level*/,
                       Vector<MultiFab>& S_stg_data,                  // at last RK stg: S^n, S^* or S^**
                       const MultiFab& S_stg_prim,                    // Primitive version of S_stg_data[IntVar::cons]
                       const MultiFab& pi_stg,                        // Exner function evaluated at last RK stg
-                      const MultiFab& fast_coeffs,                   // Coeffs for tridiagonal solve
+                      const FastMultiFab& fast_coeffs,               // Coeffs for tridiagonal solve
                       Vector<MultiFab>& S_data,                      // S_sum = state at end of this substep
                       Vector<MultiFab>& S_scratch,                   // S_sum_old at most recent fast timestep for (rho theta)
                       const amrex::Geometry geom,
                       const SolverChoice& solverChoice,
+                      ERFWorkspace& workspace,                       // Pool for scratch MultiFabs
                             MultiFab& Omega,
                       std::unique_ptr<MultiFab>& z_t_rk,             // evaluated from previous RK stg to next RK stg
                       const MultiFab* z_t_pert,                      // evaluated from tau to (tau + delta tau) - z_t_rk
@@ -59,18 +61,18 @@ void erf_fast_rhs_MT (int step, int /*level*/,
     Real dyi = dxInv[1];
     Real dzi = dxInv[2];
 
-    MultiFab     coeff_A_mf(fast_coeffs, amrex::make_alias, 0, 1);
-    MultiFab inv_coeff_B_mf(fast_coeffs, amrex::make_alias, 1, 1);
-    MultiFab     coeff_C_mf(fast_coeffs, amrex::make_alias, 2, 1);
-    MultiFab     coeff_P_mf(fast_coeffs, amrex::make_alias, 3, 1);
-    MultiFab     coeff_Q_mf(fast_coeffs, amrex::make_alias, 4, 1);
+    FastMultiFab     coeff_A_mf(fast_coeffs, amrex::make_alias, 0, 1);
+    FastMultiFab inv_coeff_B_mf(fast_coeffs, amrex::make_alias, 1, 1);
+    FastMultiFab coeff_CinvB_mf(fast_coeffs, amrex::make_alias, 2, 1);
+    FastMultiFab     coeff_P_mf(fast_coeffs, amrex::make_alias, 3, 1);
+    FastMultiFab     coeff_Q_mf(fast_coeffs, amrex::make_alias, 4, 1);
 
     // *************************************************************************
     // Set gravity as a vector
     const    Array<Real,AMREX_SPACEDIM> grav{0.0, 0.0, -solverChoice.gravity};
     const GpuArray<Real,AMREX_SPACEDIM> grav_gpu{grav[0], grav[1], grav[2]};
 
-    MultiFab extrap(S_data[IntVar::cons].boxArray(),S_data[IntVar::cons].DistributionMap(),1,1);
+    MultiFab& extrap = workspace.acquire(S_data[IntVar::cons].boxArray(),S_data[IntVar::cons].DistributionMap(),1,1);
 
     // *************************************************************************
     // Define updates in the current RK stg
@@ -183,7 +185,7 @@ void erf_fast_rhs_MT (int step, int /*level*/,
 
         auto const&     coeffA_a =     coeff_A_mf.array(mfi);
         auto const& inv_coeffB_a = inv_coeff_B_mf.array(mfi);
-        auto const&     coeffC_a =     coeff_C_mf.array(mfi);
+        auto const& coeffCinvB_a = coeff_CinvB_mf.array(mfi);
         auto const&     coeffP_a =     coeff_P_mf.array(mfi);
         auto const&     coeffQ_a =     coeff_Q_mf.array(mfi);
 
@@ -371,81 +373,17 @@ void erf_fast_rhs_MT (int step, int /*level*/,
         });
         } // end profile
 
-        amrex::Box b2d = tbz; // Copy constructor
-        b2d.setRange(2,0);
-
-        auto const lo = amrex::lbound(bx);
         auto const hi = amrex::ubound(bx);
 
         {
         BL_PROFILE("fast_rhs_b2d_loop_t");
-
-#ifdef AMREX_USE_GPU
-        ParallelFor(b2d, [=] AMREX_GPU_DEVICE (int i, int j, int)
-        {
-            // Moving terrain
-            Real rho_on_bdy = 0.5 * ( prev_cons(i,j,0) + prev_cons(i,j,-1) );
-            RHS_a(i,j,0) = rho_on_bdy * zp_t_arr(i,j,0);
-
-            soln_a(i,j,0) = RHS_a(i,j,0) * inv_coeffB_a(i,j,0);
-
-            // w_khi = 0
-            RHS_a(i,j,hi.z+1)     =  0.0;
-
-            for (int k = 1; k <= hi.z+1; k++) {
-                soln_a(i,j,k) = (RHS_a(i,j,k)-coeffA_a(i,j,k)*soln_a(i,j,k-1)) * inv_coeffB_a(i,j,k);
-            }
-
-            for (int k = hi.z; k >= 0; k--) {
-                soln_a(i,j,k) -= ( coeffC_a(i,j,k) * inv_coeffB_a(i,j,k) ) * soln_a(i,j,k+1);
-            }
-
-           // We assume that Omega == w at the top boundary and that changes in J there are irrelevant
-            cur_zmom(i,j,hi.z+1) = stg_zmom(i,j,hi.z+1) + soln_a(i,j,hi.z+1);
-        });
-#else
-        for (int j = lo.y; j <= hi.y; ++j) {
-             AMREX_PRAGMA_SIMD
-             for (int i = lo.x; i <= hi.x; ++i) {
-
-                 Real rho_on_bdy = 0.5 * ( prev_cons(i,j,0) + prev_cons(i,j,-1) );
-                 RHS_a(i,j,0) = rho_on_bdy * zp_t_arr(i,j,0);
-
-                 soln_a(i,j,0) = RHS_a(i,j,0) * inv_coeffB_a(i,j,0);
-             }
-        }
-
-        for (int j = lo.y; j <= hi.y; ++j) {
-             AMREX_PRAGMA_SIMD
-             for (int i = lo.x; i <= hi.x; ++i) {
-                 RHS_a (i,j,hi.z+1) =  0.0;
-             }
-        }
-        for (int k = lo.z+1; k <= hi.z+1; ++k) {
-             for (int j = lo.y; j <= hi.y; ++j) {
-                 AMREX_PRAGMA_SIMD
-                 for (int i = lo.x; i <= hi.x; ++i) {
-                     soln_a(i,j,k) = (RHS_a(i,j,k)-coeffA_a(i,j,k)*soln_a(i,j,k-1)) * inv_coeffB_a(i,j,k);
-                 }
-           }
-        }
-        for (int k = hi.z; k >= lo.z; --k) {
-             for (int j = lo.y; j <= hi.y; ++j) {
-                 AMREX_PRAGMA_SIMD
-                 for (int i = lo.x; i <= hi.x; ++i) {
-                     soln_a(i,j,k) -= ( coeffC_a(i,j,k) * inv_coeffB_a(i,j,k) ) * soln_a(i,j,k+1);
-                 }
-             }
-        }
-
-        // We assume that Omega == w at the top boundary and that changes in J there are irrelevant
-        for (int j = lo.y; j <= hi.y; ++j) {
-             AMREX_PRAGMA_SIMD
-             for (int i = lo.x; i <= hi.x; ++i) {
-                cur_zmom(i,j,hi.z+1) = stg_zmom(i,j,hi.z+1) + soln_a(i,j,hi.z+1);
-            }
-        }
-#endif
+        // Moving terrain: the bottom boundary value comes from the motion of the terrain; w = 0 at the top
+        fast_tridiagonal_solve(bx, RHS_a, soln_a, coeffA_a, inv_coeffB_a, coeffCinvB_a,
+                               [=] AMREX_GPU_DEVICE (int i, int j) noexcept
+                               {
+                                   Real rho_on_bdy = 0.5 * ( prev_cons(i,j,0) + prev_cons(i,j,-1) );
+                                   return rho_on_bdy * zp_t_arr(i,j,0);
+                               });
         } // end profile
 
         {
@@ -476,6 +414,11 @@ void erf_fast_rhs_MT (int step, int /*level*/,
                                - OmegaFromW(i,j,k,stg_zmom(i,j,k),stg_xmom,stg_ymom,z_nd_stg,dxInv);
                  soln_a(i,j,k) -= rho_on_face * zp_t_arr(i,j,k);
              }
+
+             // We assume that Omega == w at the top boundary and that changes in J there are irrelevant
+             if (k == hi.z) {
+                 cur_zmom(i,j,k+1) = stg_zmom(i,j,k+1) + soln_a(i,j,k+1);
+             }
         });
         } // end profile
 
@@ -519,4 +462,6 @@ void erf_fast_rhs_MT (int step, int /*level*/,
         } // end profile
     } // mfi
     }
+
+    workspace.release(extrap);
 }
@@ -7,6 +7,7 @@
 #include <ERF_Constants.H>
 #include <IndexDefines.H>
 #include <TimeIntegration.H>
+#include <ERF_TridiagonalSolve.H>
 #include <prob_common.H>
 
 using namespace amrex;
@@ -18,15 +19,18 @@ void erf_fast_rhs_N (int step, int /*level*/,
                      Vector<MultiFab>& S_stage_data,                 // S_bar = S^n, S^* or S^**
                      const MultiFab& S_stage_prim,                   // Primitive version of S_stage_data[IntVar::cons]
                      const MultiFab& pi_stage,                       // Exner function evaluated at last stage
-                     const MultiFab& fast_coeffs,                    // Coeffs for tridiagonal solve
+                     const FastMultiFab& fast_coeffs,                // Coeffs for tridiagonal solve
                      Vector<MultiFab>& S_data,                       // S_sum = most recent full solution
                      Vector<MultiFab>& S_scratch,                    // S_sum_old at most recent fast timestep for (rho theta)
                      const amrex::Geometry geom,
                      const SolverChoice& solverChoice,
+                     ERFWorkspace& workspace,                        // Pool for scratch MultiFabs
+                     int ngrow_fast,                                 // Also update this many ghost cells in x and y
                      const amrex::Real dtau, const amrex::Real facinv,
                      std::unique_ptr<MultiFab>& mapfac_m,
                      std::unique_ptr<MultiFab>& mapfac_u,
-                     std::unique_ptr<MultiFab>& mapfac_v)
+                     std::unique_ptr<MultiFab>& mapfac_v,
+                     const std::function<void()>& finish_halo_fill) // Completes a ghost cell exchange in flight
 {
     BL_PROFILE_REGION("erf_fast_rhs_N()");
 
@@ -52,22 +56,45 @@ void erf_fast_rhs_N (int step, int /*level*/,
     const auto& ba = S_stage_data[IntVar::cons].boxArray();
     const auto& dm = S_stage_data[IntVar::cons].DistributionMap();
 
-    MultiFab Delta_rho_w(    convert(ba,IntVect(0,0,1)), dm, 1, IntVect(1,1,0));
-    MultiFab Delta_rho  (            ba                , dm, 1, 1);
-    MultiFab Delta_rho_theta(        ba                , dm, 1, 1);
+    // With a deep halo these are needed one cell beyond the region we update
+    const int ng_delta = solverChoice.fast_halo_depth;
+    AMREX_ALWAYS_ASSERT(ngrow_fast < ng_delta);
 
-    MultiFab     coeff_A_mf(fast_coeffs, amrex::make_alias, 0, 1);
-    MultiFab inv_coeff_B_mf(fast_coeffs, amrex::make_alias, 1, 1);
-    MultiFab     coeff_C_mf(fast_coeffs, amrex::make_alias, 2, 1);
-    MultiFab     coeff_P_mf(fast_coeffs, amrex::make_alias, 3, 1);
-    MultiFab     coeff_Q_mf(fast_coeffs, amrex::make_alias, 4, 1);
+    // The perturbation fields are stored as FastReal (see ERF_FastReal.H)
+    FastMultiFab& Delta_rho_w     = workspace.acquire_fast(convert(ba,IntVect(0,0,1)), dm, 1, IntVect(ng_delta,ng_delta,0));
+    FastMultiFab& Delta_rho       = workspace.acquire_fast(        ba                , dm, 1, ng_delta);
+    FastMultiFab& Delta_rho_theta = workspace.acquire_fast(        ba                , dm, 1, ng_delta);
+
+    FastMultiFab     coeff_A_mf(fast_coeffs, amrex::make_alias, 0, 1);
+    FastMultiFab inv_coeff_B_mf(fast_coeffs, amrex::make_alias, 1, 1);
+    FastMultiFab coeff_CinvB_mf(fast_coeffs, amrex::make_alias, 2, 1);
+    FastMultiFab     coeff_P_mf(fast_coeffs, amrex::make_alias, 3, 1);
+    FastMultiFab     coeff_Q_mf(fast_coeffs, amrex::make_alias, 4, 1);
 
     // *************************************************************************
     // Set gravity as a vector
     const    Array<Real,AMREX_SPACEDIM> grav{0.0, 0.0, -solverChoice.gravity};
     const GpuArray<Real,AMREX_SPACEDIM> grav_gpu{grav[0], grav[1], grav[2]};
 
-    MultiFab extrap(S_data[IntVar::cons].boxArray(),S_data[IntVar::cons].DistributionMap(),1,1);
+    FastMultiFab& extrap = workspace.acquire_fast(S_data[IntVar::cons].boxArray(),S_data[IntVar::cons].DistributionMap(),1,ng_delta);
+
+    // Process each column from the explicit update through the vertical solve in a single pass?
+    const bool l_fused = solverChoice.use_fused_fast_rhs;
+
+    // If the ghost cell exchange of S_data is still in flight we make two passes: the first one
+    //    does the explicit horizontal updates on the cells and faces whose stencils lie within the
+    //    valid region of their box; then we complete the exchange and the second pass does the rest
+    const bool overlap_fill = static_cast<bool>(finish_halo_fill);
+    AMREX_ALWAYS_ASSERT(!overlap_fill || (step > 0 && ngrow_fast == 0));
+
+    for (int pass = (overlap_fill ? 0 : 1); pass < 2; ++pass)
+    {
+    const bool interior_only = (pass == 0);
+
+    if (overlap_fill && pass == 1) {
+        BL_PROFILE("fast_rhs_halo_wait");
+        finish_halo_fill();
+    }
 
     // *************************************************************************
     // Define updates in the current RK stage
@@ -77,16 +104,17 @@ void erf_fast_rhs_N (int step, int /*level*/,
 #endif
     {
 
-    FArrayBox temp_rhs_fab;
-    FArrayBox RHS_fab;
-    FArrayBox soln_fab;
+    FArrayBox     temp_rhs_fab;
+    FastFArrayBox RHS_fab;
+    FastFArrayBox soln_fab;
 
     for ( MFIter mfi(S_stage_data[IntVar::cons],TilingIfNotGPU()); mfi.isValid(); ++mfi)
     {
         const Box& valid_bx = grids_to_evolve[mfi.index()];
 
         // Construct intersection of current tilebox and valid region for updating
-        Box bx = mfi.tilebox() & valid_bx;
+        //    (grown by ngrow_fast in x and y if we are using a deep halo)
+        Box bx = fast_update_box(mfi, valid_bx, ngrow_fast, geom);
 
         Box tbx = surroundingNodes(bx,0);
         Box tby = surroundingNodes(bx,1);
@@ -98,9 +126,9 @@ void erf_fast_rhs_N (int step, int /*level*/,
         const Array4<const Real> & stage_zmom = S_stage_data[IntVar::zmom].const_array(mfi);
         const Array4<const Real> & prim       = S_stage_prim.const_array(mfi);
 
-        const Array4<Real>& old_drho_w     = Delta_rho_w.array(mfi);
-        const Array4<Real>& old_drho       = Delta_rho.array(mfi);
-        const Array4<Real>& old_drho_theta = Delta_rho_theta.array(mfi);
+        const Array4<FastReal>& old_drho_w     = Delta_rho_w.array(mfi);
+        const Array4<FastReal>& old_drho       = Delta_rho.array(mfi);
+        const Array4<FastReal>& old_drho_theta = Delta_rho_theta.array(mfi);
 
         const Array4<const Real>& slow_rhs_cons  = S_slow_rhs[IntVar::cons].const_array(mfi);
         const Array4<const Real>& slow_rhs_rho_u = S_slow_rhs[IntVar::xmom].const_array(mfi);
@@ -126,7 +154,7 @@ void erf_fast_rhs_N (int step, int /*level*/,
 
         const Array4<const Real>& pi_stage_ca = pi_stage.const_array(mfi);
 
-        const Array4<Real>& theta_extrap = extrap.array(mfi);
+        const Array4<FastReal>& theta_extrap = extrap.array(mfi);
 
         // Map factors
         const Array4<const Real>& mf_m = mapfac_m->const_array(mfi);
@@ -137,7 +165,54 @@ void erf_fast_rhs_N (int step, int /*level*/,
         Box gtbx  = mfi.nodaltilebox(0).grow(1); gtbx.setSmall(2,0);
         Box gtby  = mfi.nodaltilebox(1).grow(1); gtby.setSmall(2,0);
         Box gtbz  = mfi.nodaltilebox(2).grow(IntVect(1,1,0));
+        if (ngrow_fast > 0) {
+            gbx  = amrex::grow(bx,1);
+            gtbz = amrex::grow(tbz,IntVect(1,1,0));
+        }
 
+        // The part of the explicit update done by the first of two passes (empty otherwise)
+        Box ibx;
+        Box igbx, itbx, itby;
+        if (overlap_fill) {
+            ibx = bx & amrex::grow(valid_bx,IntVect(-1,-1,0));
+            if (ibx.ok()) {
+                igbx = amrex::grow(ibx,IntVect(1,1,0));
+                itbx = surroundingNodes(ibx,0);
+                itby = surroundingNodes(ibx,1);
+            }
+        }
+        if (interior_only) {
+            if (!ibx.ok()) continue;
+            gbx  = igbx;
+            tbx  = itbx;
+            tby  = itby;
+            gtbz = Box();
+        }
+        const Box skip_gbx = interior_only ? Box() : igbx;
+        const Box skip_tbx = interior_only ? Box() : itbx;
+        const Box skip_tby = interior_only ? Box() : itby;
+
+        if (l_fused) {
+            // Same updates as in fast_rhs_copies_{0,1,2} below but in a single pass;
+            //     every point only reads the data it has just written itself
+            BL_PROFILE("fast_rhs_fused_copies");
+            amrex::ParallelFor(gbx, gtbz,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept {
+                if (skip_gbx.contains(IntVect(i,j,k))) return;
+                if (step == 0) {
+                    cur_cons(i,j,k,Rho_comp)            = prev_cons(i,j,k,Rho_comp);
+                    cur_cons(i,j,k,RhoTheta_comp)       = prev_cons(i,j,k,RhoTheta_comp);
+                    scratch_rtheta(i,j,k,RhoTheta_comp) = prev_cons(i,j,k,RhoTheta_comp);
+                }
+                old_drho(i,j,k)       = cur_cons(i,j,k,Rho_comp)      - stage_cons(i,j,k,Rho_comp);
+                old_drho_theta(i,j,k) = cur_cons(i,j,k,RhoTheta_comp) - stage_cons(i,j,k,RhoTheta_comp);
+                theta_extrap(i,j,k)     = old_drho_theta(i,j,k) + beta_d * (
+                  (cur_cons(i,j  ,k,RhoTheta_comp) - scratch_rtheta(i,j  ,k,RhoTheta_comp)));
+            },
+            [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept {
+                old_drho_w(i,j,k) = prev_zmom(i,j,k) - stage_zmom(i,j,k);
+            });
+        } else {
         {
         BL_PROFILE("fast_rhs_copies_0");
         if (step == 0) {
@@ -161,12 +236,14 @@ void erf_fast_rhs_N (int step, int /*level*/,
         {
         BL_PROFILE("fast_rhs_copies_2");
         amrex::ParallelFor(gbx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept {
+            if (skip_gbx.contains(IntVect(i,j,k))) return;
             old_drho(i,j,k)       = cur_cons(i,j,k,Rho_comp)      - stage_cons(i,j,k,Rho_comp);
             old_drho_theta(i,j,k) = cur_cons(i,j,k,RhoTheta_comp) - stage_cons(i,j,k,RhoTheta_comp);
             theta_extrap(i,j,k)     = old_drho_theta(i,j,k) + beta_d * (
               (cur_cons(i,j  ,k,RhoTheta_comp) - scratch_rtheta(i,j  ,k,RhoTheta_comp)));
         });
         } // end profile
+        } // l_fused
 
         RHS_fab.resize(tbz,1);
         soln_fab.resize(tbz,1);
@@ -183,7 +260,7 @@ void erf_fast_rhs_N (int step, int /*level*/,
 
         auto const&     coeffA_a =     coeff_A_mf.array(mfi);
         auto const& inv_coeffB_a = inv_coeff_B_mf.array(mfi);
-        auto const&     coeffC_a =     coeff_C_mf.array(mfi);
+        auto const& coeffCinvB_a = coeff_CinvB_mf.array(mfi);
         auto const&     coeffP_a =     coeff_P_mf.array(mfi);
         auto const&     coeffQ_a =     coeff_Q_mf.array(mfi);
 
@@ -195,6 +272,8 @@ void erf_fast_rhs_N (int step, int /*level*/,
         amrex::ParallelFor(tbx, tby,
         [=] AMREX_GPU_DEVICE (int i, int j, int k)
         {
+            if (skip_tbx.contains(IntVect(i,j,k))) return;
+
             // Add (negative) gradient of (rho theta) multiplied by lagged "pi"
             Real gpx = (theta_extrap(i,j,k) - theta_extrap(i-1,j,k))*dxi;
             gpx *= mf_u(i,j,0);
@@ -217,6 +296,8 @@ void erf_fast_rhs_N (int step, int /*level*/,
         },
         [=] AMREX_GPU_DEVICE (int i, int j, int k)
         {
+            if (skip_tby.contains(IntVect(i,j,k))) return;
+
             // Add (negative) gradient of (rho theta) multiplied by lagged "pi"
             Real gpy = (theta_extrap(i,j,k) - theta_extrap(i,j-1,k))*dyi;
             gpy *= mf_v(i,j,0);
@@ -239,6 +320,115 @@ void erf_fast_rhs_N (int step, int /*level*/,
         });
         } // end profile
 
+        // Everything below reads ghost data, so it waits for the second pass
+        if (interior_only) continue;
+
+        // *********************************************************************
+        // Fused path: one (i,j) column at a time, go from the horizontal divergence
+        //     through the tridiagonal solve to the final update of rho and (rho theta).
+        //     This performs exactly the same arithmetic as the separate passes below;
+        //     only the loop order changes.  Note that each column only reads and
+        //     writes its own z-momentum, temp_rhs, RHS and soln entries so there is
+        //     no dependence between columns after the x- and y-momentum update above.
+        // *********************************************************************
+        if (l_fused) {
+            BL_PROFILE("fast_rhs_fused_column");
+
+            // Note that the notes use "g" to mean the magnitude of gravity, so it is positive
+            Real halfg = std::abs(0.5 * grav_gpu[2]);
+
+            auto const lo = amrex::lbound(bx);
+            auto const hi = amrex::ubound(bx);
+
+            amrex::Box b2d = bx; // Copy constructor
+            b2d.setRange(2,0);
+
+            ParallelFor(b2d, [=] AMREX_GPU_DEVICE (int i, int j, int)
+            {
+                // Horizontal contribution to the fast RHS of rho and (rho theta)
+                for (int k = lo.z; k <= hi.z; ++k) {
+                    Real xflux_lo = (cur_xmom(i  ,j,k) - stage_xmom(i  ,j,k)) / mf_u(i  ,j,0);
+                    Real xflux_hi = (cur_xmom(i+1,j,k) - stage_xmom(i+1,j,k)) / mf_u(i+1,j,0);
+                    Real yflux_lo = (cur_ymom(i,j  ,k) - stage_ymom(i,j  ,k)) / mf_v(i,j  ,0);
+                    Real yflux_hi = (cur_ymom(i,j+1,k) - stage_ymom(i,j+1,k)) / mf_v(i,j+1,0);
+
+                    Real mfsq = mf_m(i,j,0) * mf_m(i,j,0);
+
+                    temp_rhs_arr(i,j,k,Rho_comp     ) =  ( xflux_hi - xflux_lo ) * dxi * mfsq
+                                                       + ( yflux_hi - yflux_lo ) * dyi * mfsq;
+                    temp_rhs_arr(i,j,k,RhoTheta_comp) = (( xflux_hi * (prim(i,j,k,0) + prim(i+1,j,k,0)) -
+                                                           xflux_lo * (prim(i,j,k,0) + prim(i-1,j,k,0)) ) * dxi * mfsq +
+                                                         ( yflux_hi * (prim(i,j,k,0) + prim(i,j+1,k,0)) -
+                                                           yflux_lo * (prim(i,j,k,0) + prim(i,j-1,k,0)) ) * dyi * mfsq) * 0.5;
+                }
+
+                // RHS of the tridiagonal system; w = 0 at the bottom and top of the domain
+                RHS_a(i,j,lo.z  ) = 0.0;
+                RHS_a(i,j,hi.z+1) = 0.0;
+
+                for (int k = lo.z+1; k <= hi.z; ++k) {
+                    Real coeff_P = coeffP_a(i,j,k);
+                    Real coeff_Q = coeffQ_a(i,j,k);
+
+#ifdef ERF_USE_MOISTURE
+                    Real q = 0.5 * ( prim(i,j,k,PrimQt_comp) + prim(i,j,k-1,PrimQt_comp)
+                                    +prim(i,j,k,PrimQp_comp) + prim(i,j,k-1,PrimQp_comp) );
+                    coeff_P /= (1.0 + q);
+                    coeff_Q /= (1.0 + q);
+#endif
+
+                    Real theta_t_lo  = 0.5 * ( prim(i,j,k-2,PrimTheta_comp) + prim(i,j,k-1,PrimTheta_comp) );
+                    Real theta_t_mid = 0.5 * ( prim(i,j,k-1,PrimTheta_comp) + prim(i,j,k  ,PrimTheta_comp) );
+                    Real theta_t_hi  = 0.5 * ( prim(i,j,k  ,PrimTheta_comp) + prim(i,j,k+1,PrimTheta_comp) );
+
+                    Real Omega_kp1 = prev_zmom(i,j,k+1) - stage_zmom(i,j,k+1);
+                    Real Omega_k   = prev_zmom(i,j,k  ) - stage_zmom(i,j,k  );
+                    Real Omega_km1 = prev_zmom(i,j,k-1) - stage_zmom(i,j,k-1);
+
+                    Real R0_tmp = coeff_P * old_drho_theta(i,j,k) + coeff_Q * old_drho_theta(i,j,k-1)
+                                 - halfg * ( old_drho(i,j,k) + old_drho(i,j,k-1) );
+
+                    Real R1_tmp =  halfg * (-slow_rhs_cons(i,j,k  ,Rho_comp)
+                                            -slow_rhs_cons(i,j,k-1,Rho_comp)
+                                            +temp_rhs_arr(i,j,k,0) + temp_rhs_arr(i,j,k-1) )
+                        + ( coeff_P * (slow_rhs_cons(i,j,k  ,RhoTheta_comp) - temp_rhs_arr(i,j,k  ,RhoTheta_comp)) +
+                            coeff_Q * (slow_rhs_cons(i,j,k-1,RhoTheta_comp) - temp_rhs_arr(i,j,k-1,RhoTheta_comp)) );
+
+                    R1_tmp +=  beta_1 * dzi * ( (Omega_kp1 - Omega_km1)                         * halfg
+                                               -(Omega_kp1*theta_t_hi  - Omega_k  *theta_t_mid) * coeff_P
+                                               -(Omega_k  *theta_t_mid - Omega_km1*theta_t_lo ) * coeff_Q );
+
+                    RHS_a(i,j,k) = Omega_k + dtau * (slow_rhs_rho_w(i,j,k) + R0_tmp + dtau * beta_2 * R1_tmp);
+                }
+
+                // Forward elimination (the coefficients were already factored in make_fast_coeffs)
+                soln_a(i,j,lo.z) = RHS_a(i,j,lo.z) * inv_coeffB_a(i,j,lo.z);
+                for (int k = lo.z+1; k <= hi.z+1; ++k) {
+                    soln_a(i,j,k) = (RHS_a(i,j,k)-coeffA_a(i,j,k)*soln_a(i,j,k-1)) * inv_coeffB_a(i,j,k);
+                }
+                cur_zmom(i,j,hi.z+1) = stage_zmom(i,j,hi.z+1) + soln_a(i,j,hi.z+1);
+
+                // Back substitution -- once soln_a(k) is known, so are both fluxes of cell k
+                for (int k = hi.z; k >= lo.z; --k) {
+                    soln_a(i,j,k) -= coeffCinvB_a(i,j,k) * soln_a(i,j,k+1);
+                    cur_zmom(i,j,k) = stage_zmom(i,j,k) + soln_a(i,j,k);
+
+                    Real zflux_lo = beta_2 * soln_a(i,j,k  ) + beta_1 * old_drho_w(i,j,k  );
+                    Real zflux_hi = beta_2 * soln_a(i,j,k+1) + beta_1 * old_drho_w(i,j,k+1);
+
+                    avg_zmom(i,j,k  ) += facinv*zflux_lo;
+
+                    cur_cons(i,j,k,0) += dtau * (slow_rhs_cons(i,j,k,0) - temp_rhs_arr(i,j,k,0) - ( zflux_hi - zflux_lo ) * dzi );
+
+                    cur_cons(i,j,k,1) += dtau * (slow_rhs_cons(i,j,k,1) - temp_rhs_arr(i,j,k,1) - 0.5 * (
+                      ( zflux_hi * (prim(i,j,k) + prim(i,j,k+1)) - zflux_lo * (prim(i,j,k) + prim(i,j,k-1)) ) * dzi ) );
+                }
+            });
+
+            // The remaining passes below are the unfused version of the above
+            continue;
+        }
+
         // *********************************************************************
         {
         BL_PROFILE("making_rho_rhs");
@@ -319,76 +509,12 @@ void erf_fast_rhs_N (int step, int /*level*/,
         });
         } // end profile
 
-        amrex::Box b2d = tbz; // Copy constructor
-        b2d.setRange(2,0);
-
         {
         BL_PROFILE("fast_rhs_b2d_loop");
-#ifdef AMREX_USE_GPU
-        auto const hi = amrex::ubound(bx);
-        ParallelFor(b2d, [=] AMREX_GPU_DEVICE (int i, int j, int)
-        {
-          // w_0 = 0
-          RHS_a   (i,j,0) =  0.0;
-
-          // w_khi = 0
-          // Note that if we ever change this, we will need to include it in avg_zmom at the top
-          RHS_a   (i,j,hi.z+1) =  0.0;
-
-          // w = 0 at k = 0
-          soln_a(i,j,0) = RHS_a(i,j,0) * inv_coeffB_a(i,j,0);
-          cur_zmom(i,j,0) = stage_zmom(i,j,0) + soln_a(i,j,0);
-
-          for (int k = 1; k <= hi.z+1; k++) {
-              soln_a(i,j,k) = (RHS_a(i,j,k)-coeffA_a(i,j,k)*soln_a(i,j,k-1)) * inv_coeffB_a(i,j,k);
-          }
-          cur_zmom(i,j,hi.z+1) = stage_zmom(i,j,hi.z+1) + soln_a(i,j,hi.z+1);
-          for (int k = hi.z; k >= 0; k--) {
-              soln_a(i,j,k) -= ( coeffC_a(i,j,k) * inv_coeffB_a(i,j,k) ) *soln_a(i,j,k+1);
-              cur_zmom(i,j,k) = stage_zmom(i,j,k) + soln_a(i,j,k);
-          }
-        }); // b2d
-#else
-        auto const lo = amrex::lbound(bx);
-        auto const hi = amrex::ubound(bx);
-        for (int j = lo.y; j <= hi.y; ++j) {
-            AMREX_PRAGMA_SIMD
-            for (int i = lo.x; i <= hi.x; ++i) {
-                RHS_a   (i,j,0) =  0.0;
-                soln_a(i,j,0) = RHS_a(i,j,0) * inv_coeffB_a(i,j,0);
-            }
-        }
-        // Note that if we ever change this, we will need to include it in avg_zmom at the top
-        for (int j = lo.y; j <= hi.y; ++j) {
-            AMREX_PRAGMA_SIMD
-            for (int i = lo.x; i <= hi.x; ++i) {
-                RHS_a   (i,j,hi.z+1) =  0.0;
-            }
-        }
-        for (int k = lo.z+1; k <= hi.z+1; ++k) {
-            for (int j = lo.y; j <= hi.y; ++j) {
-                AMREX_PRAGMA_SIMD
-                for (int i = lo.x; i <= hi.x; ++i) {
-                    soln_a(i,j,k) = (RHS_a(i,j,k)-coeffA_a(i,j,k)*soln_a(i,j,k-1)) * inv_coeffB_a(i,j,k);
-                }
-            }
-        }
-        for (int j = lo.y; j <= hi.y; ++j) {
-            AMREX_PRAGMA_SIMD
-            for (int i = lo.x; i <= hi.x; ++i) {
-                cur_zmom(i,j,hi.z+1) = stage_zmom(i,j,hi.z+1) + soln_a(i,j,hi.z+1);
-            }
-        }
-        for (int k = hi.z; k >= lo.z; --k) {
-            for (int j = lo.y; j <= hi.y; ++j) {
-                AMREX_PRAGMA_SIMD
-                for (int i = lo.x; i <= hi.x; ++i) {
-                    soln_a(i,j,k) -= ( coeffC_a(i,j,k) * inv_coeffB_a(i,j,k) ) * soln_a(i,j,k+1);
-                    cur_zmom(i,j,k) = stage_zmom(i,j,k) + soln_a(i,j,k);
-                }
-            }
-        }
-#endif
+        // w = 0 at the bottom and at the top of the domain
+        // Note that if we ever change the top value, we will need to include it in avg_zmom at the top
+        fast_tridiagonal_solve(bx, RHS_a, soln_a, coeffA_a, inv_coeffB_a, coeffCinvB_a,
+                               [=] AMREX_GPU_DEVICE (int, int) noexcept { return Real(0.0); });
         } // end profile
 
         // **************************************************************************
@@ -398,10 +524,17 @@ void erf_fast_rhs_N (int step, int /*level*/,
         // We note that valid_bx is the actual grid, while bx may be a tile within that grid
         // const auto& vbx_hi = amrex::ubound(valid_bx);
 
+        const int bx_hi_z = bx.bigEnd(2);
+
         {
         BL_PROFILE("fast_rho_final_update");
         amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
         {
+            cur_zmom(i,j,k) = stage_zmom(i,j,k) + soln_a(i,j,k);
+            if (k == bx_hi_z) {
+                cur_zmom(i,j,k+1) = stage_zmom(i,j,k+1) + soln_a(i,j,k+1);
+            }
+
             Real zflux_lo = beta_2 * soln_a(i,j,k  ) + beta_1 * old_drho_w(i,j,k  );
             Real zflux_hi = beta_2 * soln_a(i,j,k+1) + beta_1 * old_drho_w(i,j,k+1);
 
@@ -418,4 +551,10 @@ void erf_fast_rhs_N (int step, int /*level*/,
         } // end profile
     } // mfi
     }
+    } // pass
+
+    workspace.release(Delta_rho_w);
+    workspace.release(Delta_rho);
+    workspace.release(Delta_rho_theta);
+    workspace.release(extrap);
 }
@@ -8,6 +8,7 @@
 #include <IndexDefines.H>
 #include <TerrainMetrics.H>
 #include <TimeIntegration.H>
+#include <ERF_TridiagonalSolve.H>
 #include <prob_common.H>
 
 using namespace amrex;
@@ -19,14 +20,16 @@ void erf_fast_rhs_T (int step, int /*level*/,
                      Vector<MultiFab>& S_stage_data,                 // S_bar = S^n, S^* or S^**
                      const MultiFab& S_stage_prim,                   // Primitive version of S_stage_data[IntVar::cons]
                      const MultiFab& pi_stage,                       // Exner function evaluated at last stage
-                     const MultiFab& fast_coeffs,                    // Coeffs for tridiagonal solve
+                     const FastMultiFab& fast_coeffs,                // Coeffs for tridiagonal solve
                      Vector<MultiFab>& S_data,                       // S_sum = most recent full solution
                      Vector<MultiFab>& S_scratch,                    // S_sum_old at most recent fast timestep for (rho theta)
                      const amrex::Geometry geom,
                      const SolverChoice& solverChoice,
+                     ERFWorkspace& workspace,                        // Pool for scratch MultiFabs
                            MultiFab& Omega,
                      std::unique_ptr<MultiFab>& z_phys_nd,
                      std::unique_ptr<MultiFab>& detJ_cc,
+                     const Vector<MultiFab>& face_met,               // cached face metrics, or empty
                      const amrex::Real dtau, const amrex::Real facinv,
                      std::unique_ptr<MultiFab>& mapfac_m,
                      std::unique_ptr<MultiFab>& mapfac_u,
@@ -36,6 +39,8 @@ void erf_fast_rhs_T (int step, int /*level*/,
 
     AMREX_ASSERT(solverChoice.terrain_type == 0);
 
+    const bool l_use_met_cache = !face_met.empty();
+
     // Per p2902 of Klemp-Skamarock-Dudhia-2007
     // beta_s = -1.0 : fully explicit
     // beta_s =  1.0 : fully implicit
@@ -55,27 +60,30 @@ void erf_fast_rhs_T (int step, int /*level*/,
     const auto& ba = S_stage_data[IntVar::cons].boxArray();
     const auto& dm = S_stage_data[IntVar::cons].DistributionMap();
 
-    MultiFab Delta_rho_u(    convert(ba,IntVect(1,0,0)), dm, 1, 1);
-    MultiFab Delta_rho_v(    convert(ba,IntVect(0,1,0)), dm, 1, 1);
-    MultiFab Delta_rho_w(    convert(ba,IntVect(0,0,1)), dm, 1, IntVect(1,1,0));
-    MultiFab Delta_rho  (            ba                , dm, 1, 1);
-    MultiFab Delta_rho_theta(        ba                , dm, 1, 1);
+    // The horizontal momentum perturbations stay in Real since they are passed to the
+    //    terrain metric routines (OmegaFromW, WFromOmega); the rest are FastReal
+    MultiFab& Delta_rho_u = workspace.acquire(convert(ba,IntVect(1,0,0)), dm, 1, 1);
+    MultiFab& Delta_rho_v = workspace.acquire(convert(ba,IntVect(0,1,0)), dm, 1, 1);
+
+    FastMultiFab& Delta_rho_w     = workspace.acquire_fast(convert(ba,IntVect(0,0,1)), dm, 1, IntVect(1,1,0));
+    FastMultiFab& Delta_rho       = workspace.acquire_fast(        ba                , dm, 1, 1);
+    FastMultiFab& Delta_rho_theta = workspace.acquire_fast(        ba                , dm, 1, 1);
 
-    MultiFab New_rho_u(convert(ba,IntVect(1,0,0)), dm, 1, 1);
-    MultiFab New_rho_v(convert(ba,IntVect(0,1,0)), dm, 1, 1);
+    MultiFab& New_rho_u = workspace.acquire(convert(ba,IntVect(1,0,0)), dm, 1, 1);
+    MultiFab& New_rho_v = workspace.acquire(convert(ba,IntVect(0,1,0)), dm, 1, 1);
 
-    MultiFab     coeff_A_mf(fast_coeffs, amrex::make_alias, 0, 1);
-    MultiFab inv_coeff_B_mf(fast_coeffs, amrex::make_alias, 1, 1);
-    MultiFab     coeff_C_mf(fast_coeffs, amrex::make_alias, 2, 1);
-    MultiFab     coeff_P_mf(fast_coeffs, amrex::make_alias, 3, 1);
-    MultiFab     coeff_Q_mf(fast_coeffs, amrex::make_alias, 4, 1);
+    FastMultiFab     coeff_A_mf(fast_coeffs, amrex::make_alias, 0, 1);
+    FastMultiFab inv_coeff_B_mf(fast_coeffs, amrex::make_alias, 1, 1);
+    FastMultiFab coeff_CinvB_mf(fast_coeffs, amrex::make_alias, 2, 1);
+    FastMultiFab     coeff_P_mf(fast_coeffs, amrex::make_alias, 3, 1);
+    FastMultiFab     coeff_Q_mf(fast_coeffs, amrex::make_alias, 4, 1);
 
     // *************************************************************************
     // Set gravity as a vector
     const    Array<Real,AMREX_SPACEDIM> grav{0.0, 0.0, -solverChoice.gravity};
     const GpuArray<Real,AMREX_SPACEDIM> grav_gpu{grav[0], grav[1], grav[2]};
 
-    MultiFab extrap(S_data[IntVar::cons].boxArray(),S_data[IntVar::cons].DistributionMap(),1,1);
+    FastMultiFab& extrap = workspace.acquire_fast(S_data[IntVar::cons].boxArray(),S_data[IntVar::cons].DistributionMap(),1,1);
 
     // *************************************************************************
     // Define updates in the current RK stage
@@ -85,9 +93,9 @@ void erf_fast_rhs_T (int step, int /*level*/,
 #endif
     {
 
-    FArrayBox temp_rhs_fab;
-    FArrayBox RHS_fab;
-    FArrayBox soln_fab;
+    FArrayBox     temp_rhs_fab;
+    FastFArrayBox RHS_fab;
+    FastFArrayBox soln_fab;
 
     for ( MFIter mfi(S_stage_data[IntVar::cons],TilingIfNotGPU()); mfi.isValid(); ++mfi)
     {
@@ -108,9 +116,9 @@ void erf_fast_rhs_T (int step, int /*level*/,
 
         const Array4<Real>& old_drho_u     = Delta_rho_u.array(mfi);
         const Array4<Real>& old_drho_v     = Delta_rho_v.array(mfi);
-        const Array4<Real>& old_drho_w     = Delta_rho_w.array(mfi);
-        const Array4<Real>& old_drho       = Delta_rho.array(mfi);
-        const Array4<Real>& old_drho_theta = Delta_rho_theta.array(mfi);
+        const Array4<FastReal>& old_drho_w     = Delta_rho_w.array(mfi);
+        const Array4<FastReal>& old_drho       = Delta_rho.array(mfi);
+        const Array4<FastReal>& old_drho_theta = Delta_rho_theta.array(mfi);
 
         const Array4<const Real>& slow_rhs_cons  = S_slow_rhs[IntVar::cons].const_array(mfi);
         const Array4<const Real>& slow_rhs_rho_u = S_slow_rhs[IntVar::xmom].const_array(mfi);
@@ -140,11 +148,16 @@ void erf_fast_rhs_T (int step, int /*level*/,
         const Array4<const Real>& z_nd   = z_phys_nd->const_array(mfi);
         const Array4<const Real>& detJ   = detJ_cc->const_array(mfi);
 
+        // Cached metric terms on the faces, or empty arrays if we compute them from z_nd
+        const Array4<const Real>& met_x  = l_use_met_cache ? face_met[0].const_array(mfi) : Array4<const Real>{};
+        const Array4<const Real>& met_y  = l_use_met_cache ? face_met[1].const_array(mfi) : Array4<const Real>{};
+        const Array4<const Real>& met_z  = l_use_met_cache ? face_met[2].const_array(mfi) : Array4<const Real>{};
+
         const Array4<      Real>& omega_arr = Omega.array(mfi);
 
         const Array4<const Real>& pi_stage_ca = pi_stage.const_array(mfi);
 
-        const Array4<Real>& theta_extrap = extrap.array(mfi);
+        const Array4<FastReal>& theta_extrap = extrap.array(mfi);
 
         // Map factors
         const Array4<const Real>& mf_m = mapfac_m->const_array(mfi);
@@ -211,7 +224,7 @@ void erf_fast_rhs_T (int step, int /*level*/,
 
         auto const&     coeffA_a =     coeff_A_mf.array(mfi);
         auto const& inv_coeffB_a = inv_coeff_B_mf.array(mfi);
-        auto const&     coeffC_a =     coeff_C_mf.array(mfi);
+        auto const& coeffCinvB_a = coeff_CinvB_mf.array(mfi);
         auto const&     coeffP_a =     coeff_P_mf.array(mfi);
         auto const&     coeffQ_a =     coeff_Q_mf.array(mfi);
 
@@ -224,8 +237,8 @@ void erf_fast_rhs_T (int step, int /*level*/,
         [=] AMREX_GPU_DEVICE (int i, int j, int k)
         {
                 // Add (negative) gradient of (rho theta) multiplied by lagged "pi"
-                Real met_h_xi   = Compute_h_xi_AtIface  (i, j, k, dxInv, z_nd);
-                Real met_h_zeta = Compute_h_zeta_AtIface(i, j, k, dxInv, z_nd);
+                Real met_h_xi   = Get_h_xi_AtIface  (i, j, k, dxInv, z_nd, met_x);
+                Real met_h_zeta = Get_h_zeta_AtIface(i, j, k, dxInv, z_nd, met_x);
                 Real gp_xi = (theta_extrap(i,j,k) - theta_extrap(i-1,j,k)) * dxi;
                 Real gp_zeta_on_iface = (k == 0) ?
                    0.5  * dzi * ( theta_extrap(i-1,j,k+1) + theta_extrap(i,j,k+1)
@@ -253,8 +266,8 @@ void erf_fast_rhs_T (int step, int /*level*/,
             [=] AMREX_GPU_DEVICE (int i, int j, int k)
             {
                 // Add (negative) gradient of (rho theta) multiplied by lagged "pi"
-                Real met_h_eta  = Compute_h_eta_AtJface(i, j, k, dxInv, z_nd);
-                Real met_h_zeta = Compute_h_zeta_AtJface(i, j, k, dxInv, z_nd);
+                Real met_h_eta  = Get_h_eta_AtJface (i, j, k, dxInv, z_nd, met_y);
+                Real met_h_zeta = Get_h_zeta_AtJface(i, j, k, dxInv, z_nd, met_y);
                 Real gp_eta = (theta_extrap(i,j,k) -theta_extrap(i,j-1,k)) * dyi;
                 Real gp_zeta_on_jface = (k == 0) ?
                     0.5  * dzi * ( theta_extrap(i,j,k+1) + theta_extrap(i,j-1,k+1)
@@ -286,21 +299,11 @@ void erf_fast_rhs_T (int step, int /*level*/,
         BL_PROFILE("fast_T_making_rho_rhs");
         amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
         {
-            Real h_zeta_cc_xface_hi = 0.5 * dzi *
-              (  z_nd(i+1,j  ,k+1) + z_nd(i+1,j+1,k+1)
-                -z_nd(i+1,j  ,k  ) - z_nd(i+1,j+1,k  ) );
-
-            Real h_zeta_cc_xface_lo = 0.5 * dzi *
-              (  z_nd(i  ,j  ,k+1) + z_nd(i  ,j+1,k+1)
-            -z_nd(i  ,j  ,k  ) - z_nd(i  ,j+1,k  ) );
-
-            Real h_zeta_cc_yface_hi = 0.5 * dzi *
-              (  z_nd(i  ,j+1,k+1) + z_nd(i+1,j+1,k+1)
-                -z_nd(i  ,j+1,k  ) - z_nd(i+1,j+1,k  ) );
+            Real h_zeta_cc_xface_hi = Get_h_zeta_AtIface(i+1, j  , k, dxInv, z_nd, met_x);
+            Real h_zeta_cc_xface_lo = Get_h_zeta_AtIface(i  , j  , k, dxInv, z_nd, met_x);
 
-            Real h_zeta_cc_yface_lo = 0.5 * dzi *
-              (  z_nd(i  ,j  ,k+1) + z_nd(i+1,j  ,k+1)
-                -z_nd(i  ,j  ,k  ) - z_nd(i+1,j  ,k  ) );
+            Real h_zeta_cc_yface_hi = Get_h_zeta_AtJface(i  , j+1, k, dxInv, z_nd, met_y);
+            Real h_zeta_cc_yface_lo = Get_h_zeta_AtJface(i  , j  , k, dxInv, z_nd, met_y);
 
             Real xflux_lo = new_drho_u(i  ,j,k)*h_zeta_cc_xface_lo / mf_u(i  ,j,0);;
             Real xflux_hi = new_drho_u(i+1,j,k)*h_zeta_cc_xface_hi / mf_u(i+1,j,0);;
@@ -345,7 +348,7 @@ void erf_fast_rhs_T (int step, int /*level*/,
         //Note we don't act on the bottom or top boundaries of the domain
         ParallelFor(bx_shrunk_in_k, [=] AMREX_GPU_DEVICE (int i, int j, int k)
         {
-            Real     detJ_on_kface = 0.5 * (detJ(i,j,k) + detJ(i,j,k-1));
+            Real     detJ_on_kface = Get_detJ_AtKface(i, j, k, detJ, met_z);
 
             Real coeff_P = coeffP_a(i,j,k);
             Real coeff_Q = coeffQ_a(i,j,k);
@@ -393,70 +396,13 @@ void erf_fast_rhs_T (int step, int /*level*/,
         });
         } // end profile
 
-        amrex::Box b2d = tbz; // Copy constructor
-        b2d.setRange(2,0);
-
-        auto const lo = amrex::lbound(bx);
         auto const hi = amrex::ubound(bx);
 
         {
         BL_PROFILE("fast_rhs_b2d_loop_t");
-#ifdef AMREX_USE_GPU
-        ParallelFor(b2d, [=] AMREX_GPU_DEVICE (int i, int j, int)
-        {
-            // w_0 = 0  w_khi = 0
-            RHS_a(i,j     ,0) =  0.0;
-            RHS_a(i,j,hi.z+1) =  0.0;
-
-            // w = 0 at k = 0
-            soln_a(i,j,0) = 0.;
-
-            for (int k = 1; k <= hi.z+1; k++) {
-                soln_a(i,j,k) = (RHS_a(i,j,k)-coeffA_a(i,j,k)*soln_a(i,j,k-1)) * inv_coeffB_a(i,j,k);
-            }
-            cur_zmom(i,j,hi.z+1) = stage_zmom(i,j,hi.z+1) + soln_a(i,j,hi.z+1);
-            for (int k = hi.z; k >= 0; k--) {
-                soln_a(i,j,k) -= ( coeffC_a(i,j,k) * inv_coeffB_a(i,j,k) ) *soln_a(i,j,k+1);
-            }
-        });
-#else
-        for (int j = lo.y; j <= hi.y; ++j) {
-            AMREX_PRAGMA_SIMD
-            for (int i = lo.x; i <= hi.x; ++i) {
-                RHS_a (i,j,0) =  0.0;
-               soln_a(i,j,0) = RHS_a(i,j,0) * inv_coeffB_a(i,j,0);
-           }
-        }
-
-        for (int j = lo.y; j <= hi.y; ++j) {
-             AMREX_PRAGMA_SIMD
-             for (int i = lo.x; i <= hi.x; ++i) {
-                 RHS_a (i,j,hi.z+1) =  0.0;
-             }
-        }
-        for (int k = lo.z+1; k <= hi.z+1; ++k) {
-             for (int j = lo.y; j <= hi.y; ++j) {
-                 AMREX_PRAGMA_SIMD
-                 for (int i = lo.x; i <= hi.x; ++i) {
-                     soln_a(i,j,k) = (RHS_a(i,j,k)-coeffA_a(i,j,k)*soln_a(i,j,k-1)) * inv_coeffB_a(i,j,k);
-                 }
-           }
-        }
-        for (int k = hi.z; k >= lo.z; --k) {
-             for (int j = lo.y; j <= hi.y; ++j) {
-                 AMREX_PRAGMA_SIMD
-                 for (int i = lo.x; i <= hi.x; ++i) {
-                     soln_a(i,j,k) -= (coeffC_a(i,j,k) * inv_coeffB_a(i,j,k)) * soln_a(i,j,k+1);
-                 }
-             }
-        }
-        for (int j = lo.y; j <= hi.y; ++j) {
-             AMREX_PRAGMA_SIMD
-             for (int i = lo.x; i <= hi.x; ++i) {
-                cur_zmom(i,j,hi.z+1) = stage_zmom(i,j,hi.z+1) + soln_a(i,j,hi.z+1);
-            }
-        }
-#endif
+        // w = 0 at k = 0 and at the top of the domain
+        fast_tridiagonal_solve(bx, RHS_a, soln_a, coeffA_a, inv_coeffB_a, coeffCinvB_a,
+                               [=] AMREX_GPU_DEVICE (int, int) noexcept { return Real(0.0); });
         } // end profile
 
         {
@@ -466,6 +412,10 @@ void erf_fast_rhs_T (int step, int /*level*/,
         {
               Real wpp = WFromOmega(i,j,k,soln_a(i,j,k),new_drho_u,new_drho_v,z_nd,dxInv);
               cur_zmom(i,j,k) = stage_zmom(i,j,k) + wpp;
+
+              if (k == hi.z) {
+                  cur_zmom(i,j,k+1) = stage_zmom(i,j,k+1) + soln_a(i,j,k+1);
+              }
         });
         } // end profile
 
@@ -497,4 +447,13 @@ void erf_fast_rhs_T (int step, int /*level*/,
         } // end profile
     } // mfi
     }
+
+    workspace.release(Delta_rho_u);
+    workspace.release(Delta_rho_v);
+    workspace.release(Delta_rho_w);
+    workspace.release(Delta_rho);
+    workspace.release(Delta_rho_theta);
+    workspace.release(New_rho_u);
+    workspace.release(New_rho_v);
+    workspace.release(extrap);
 }
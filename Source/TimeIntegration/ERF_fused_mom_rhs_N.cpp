@@ -0,0 +1,256 @@
+#include <IndexDefines.H>
+#include <EOS.H>
+#include <Advection.H>
+#include <AdvectionSrcForMom_N.H>
+#include <TimeIntegration.H>
+
+using namespace amrex;
+
+/**
+ * Slow RHS of the x-, y- and z-momenta without terrain, in a single pass over each type of face
+ *
+ * This does the work of AdvectionSrcForMom, DiffusionSrcForMom_N and the loops over tbx, tby
+ * and tbz in erf_slow_rhs_pre that add the pressure gradient, buoyancy, external forcing,
+ * Coriolis and Rayleigh damping. The terms are added in the same order, so the result is the
+ * same, but the RHS is written once per face instead of read and written in every pass.
+ *
+ * bxz must exclude the bottom and top faces; the RHS there is set to zero by the caller.
+ */
+template <int order, bool use_mf>
+void
+FusedMomRHS_N (const Box& bxx, const Box& bxy, const Box& bxz,
+               const Array4<      Real>& rho_u_rhs,
+               const Array4<      Real>& rho_v_rhs,
+               const Array4<      Real>& rho_w_rhs,
+               const Array4<const Real>& u,
+               const Array4<const Real>& v,
+               const Array4<const Real>& w,
+               const Array4<const Real>& rho_u,
+               const Array4<const Real>& rho_v,
+               const Array4<const Real>& rho_w,
+               const Array4<const Real>& Omega,
+               const Array4<const Real>& tau11,
+               const Array4<const Real>& tau22,
+               const Array4<const Real>& tau33,
+               const Array4<const Real>& tau12,
+               const Array4<const Real>& tau13,
+               const Array4<const Real>& tau23,
+               const Array4<const Real>& cell_data,
+               const Array4<const Real>& cell_prim,
+               const Array4<const Real>& pp_arr,
+               const Array4<const Real>& r0_arr,
+               const Array4<const Real>& p0_arr,
+#ifdef ERF_USE_MOISTURE
+               const Array4<const Real>& qv_data,
+               const Array4<const Real>& qc_data,
+               const Array4<const Real>& qi_data,
+#endif
+               const GpuArray<Real, AMREX_SPACEDIM>& dxInv,
+               const Array4<const Real>& mf_m,
+               const Array4<const Real>& mf_u,
+               const Array4<const Real>& mf_v,
+               int domhi_z, const MomentumForcing& forcing)
+{
+    BL_PROFILE_VAR("FusedMomRHS_N()", FusedMomRHS_N);
+
+    AMREX_ALWAYS_ASSERT(bxz.smallEnd(2) > 0);
+
+    auto dxinv = dxInv[0], dyinv = dxInv[1], dzinv = dxInv[2];
+
+    const GpuArray<Real,AMREX_SPACEDIM> ext_forcing = forcing.ext_forcing;
+    const GpuArray<Real,AMREX_SPACEDIM> grav_gpu    = forcing.grav;
+
+    const bool l_use_diff = forcing.use_diff;
+    const bool l_consA    = forcing.rho_weighted;
+    const Real rho0_trans = forcing.rho0_trans;
+
+    const bool l_use_coriolis  = forcing.use_coriolis;
+    const Real coriolis_factor = forcing.coriolis_factor;
+    const Real sinphi          = forcing.sinphi;
+    const Real cosphi          = forcing.cosphi;
+
+    const bool  l_use_rayleigh = (forcing.rayleigh_tau != nullptr);
+    const Real* rayleigh_tau   = forcing.rayleigh_tau;
+    const Real* rayleigh_ubar  = forcing.rayleigh_ubar;
+    const Real* rayleigh_vbar  = forcing.rayleigh_vbar;
+
+    const bool l_anelastic = forcing.anelastic;
+
+#ifdef ERF_USE_MOISTURE
+    const Real*   rho_d_ptr = forcing.rho_d;
+    const Real* theta_d_ptr = forcing.theta_d;
+    const Real*    qv_d_ptr = forcing.qv_d;
+    const Real*    qc_d_ptr = forcing.qc_d;
+    const Real*    qi_d_ptr = forcing.qi_d;
+    const Real*    qp_d_ptr = forcing.qp_d;
+#else
+    amrex::ignore_unused(cell_prim);
+#endif
+
+    amrex::ParallelFor(bxx, bxy, bxz,
+    [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+    { // x-momentum equation
+        Real rhs = -AdvectionSrcForXMom_N<order,use_mf>(i, j, k, rho_u, rho_v, Omega, u, dxInv, mf_u, mf_v);
+
+        if (l_use_diff) {
+            Real mf = mf_m(i,j,0);
+            Real diffContrib  = ( (tau11(i  , j  , k  ) - tau11(i-1, j  ,k  )) * dxinv * mf
+                                + (tau12(i  , j+1, k  ) - tau12(i  , j  ,k  )) * dyinv * mf
+                                + (tau13(i  , j  , k+1) - tau13(i  , j  ,k  )) * dzinv );
+            if (l_consA) {
+                diffContrib *= 0.5 * (cell_data(i,j,k,Rho_comp) + cell_data(i-1,j,k,Rho_comp)) / rho0_trans;
+            }
+            rhs += diffContrib;
+        }
+
+        Real gpx = dxinv * (pp_arr(i,j,k) - pp_arr(i-1,j,k));
+        gpx *= mf_u(i,j,0);
+#ifdef ERF_USE_MOISTURE
+        Real q = 0.5 * ( cell_prim(i,j,k,PrimQt_comp) + cell_prim(i-1,j,k,PrimQt_comp)
+                        +cell_prim(i,j,k,PrimQp_comp) + cell_prim(i-1,j,k,PrimQp_comp) );
+        rhs -= gpx / (1.0 + q);
+#else
+        rhs -= gpx;
+#endif
+        rhs += ext_forcing[0];
+
+        if (l_use_coriolis) {
+            Real rho_v_loc = 0.25 * (rho_v(i,j+1,k) + rho_v(i,j,k) + rho_v(i-1,j+1,k) + rho_v(i-1,j,k));
+            Real rho_w_loc = 0.25 * (rho_w(i,j,k+1) + rho_w(i,j,k) + rho_w(i,j-1,k+1) + rho_w(i,j-1,k));
+            rhs += coriolis_factor * (rho_v_loc * sinphi - rho_w_loc * cosphi);
+        }
+
+        if (l_use_rayleigh) {
+            Real uu = rho_u(i,j,k) / cell_data(i,j,k,Rho_comp);
+            rhs -= rayleigh_tau[k] * (uu - rayleigh_ubar[k]) * cell_data(i,j,k,Rho_comp);
+        }
+
+        rho_u_rhs(i,j,k) = rhs;
+    },
+    [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+    { // y-momentum equation
+        Real rhs = -AdvectionSrcForYMom_N<order,use_mf>(i, j, k, rho_u, rho_v, Omega, v, dxInv, mf_u, mf_v);
+
+        if (l_use_diff) {
+            Real mf = mf_m(i,j,0);
+            Real diffContrib  = ( (tau12(i+1, j  , k  ) - tau12(i  , j  , k  )) * dxinv * mf
+                                + (tau22(i  , j  , k  ) - tau22(i  , j-1, k  )) * dyinv * mf
+                                + (tau23(i  , j  , k+1) - tau23(i  , j  , k  )) * dzinv );
+            if (l_consA) {
+                diffContrib *= 0.5 * (cell_data(i,j,k,Rho_comp) + cell_data(i,j-1,k,Rho_comp)) / rho0_trans;
+            }
+            rhs += diffContrib;
+        }
+
+        Real gpy = dyinv * (pp_arr(i,j,k) - pp_arr(i,j-1,k));
+        gpy *= mf_v(i,j,0);
+#ifdef ERF_USE_MOISTURE
+        Real q = 0.5 * ( cell_prim(i,j,k,PrimQt_comp) + cell_prim(i,j-1,k,PrimQt_comp)
+                        +cell_prim(i,j,k,PrimQp_comp) + cell_prim(i,j-1,k,PrimQp_comp) );
+        rhs -= gpy / (1.0 + q);
+#else
+        rhs -= gpy;
+#endif
+        rhs += ext_forcing[1];
+
+        if (l_use_coriolis) {
+            Real rho_u_loc = 0.25 * (rho_u(i+1,j,k) + rho_u(i,j,k) + rho_u(i+1,j-1,k) + rho_u(i,j-1,k));
+            rhs += -coriolis_factor * rho_u_loc * sinphi;
+        }
+
+        if (l_use_rayleigh) {
+            Real vv = rho_v(i,j,k) / cell_data(i,j,k,Rho_comp);
+            rhs -= rayleigh_tau[k] * (vv - rayleigh_vbar[k]) * cell_data(i,j,k,Rho_comp);
+        }
+
+        rho_v_rhs(i,j,k) = rhs;
+    },
+    [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+    { // z-momentum equation
+        Real rhs = -AdvectionSrcForZMom_N<order,use_mf>(i, j, k, rho_u, rho_v, Omega, w, dxInv, mf_m, mf_u, mf_v, domhi_z);
+
+        if (l_use_diff) {
+            Real mf = mf_m(i,j,0);
+            Real diffContrib  = ( (tau13(i+1, j  , k  ) - tau13(i  , j  , k  )) * dxinv * mf
+                                + (tau23(i  , j+1, k  ) - tau23(i  , j  , k  )) * dyinv * mf
+                                + (tau33(i  , j  , k  ) - tau33(i  , j  , k-1)) * dzinv );
+            if (l_consA) {
+                diffContrib *= 0.5 * (cell_data(i,j,k,Rho_comp) + cell_data(i,j,k-1,Rho_comp)) / rho0_trans;
+            }
+            rhs += diffContrib;
+        }
+
+        Real gpz = dzinv * ( pp_arr(i,j,k)-pp_arr(i,j,k-1) );
+#ifdef ERF_USE_MOISTURE
+        Real q = 0.5 * ( cell_prim(i,j,k,PrimQt_comp) + cell_prim(i,j,k-1,PrimQt_comp)
+                        +cell_prim(i,j,k,PrimQp_comp) + cell_prim(i,j,k-1,PrimQp_comp) );
+        rhs -= gpz / (1.0 + q);
+
+        // Buoyancy
+        Real tempp1d = getTgivenRandRTh(rho_d_ptr[k  ], rho_d_ptr[k  ]*theta_d_ptr[k  ]);
+        Real tempm1d = getTgivenRandRTh(rho_d_ptr[k-1], rho_d_ptr[k-1]*theta_d_ptr[k-1]);
+
+        Real tempp3d  = getTgivenRandRTh(cell_data(i,j,k  ,Rho_comp), cell_data(i,j,k  ,RhoTheta_comp));
+        Real tempm3d  = getTgivenRandRTh(cell_data(i,j,k-1,Rho_comp), cell_data(i,j,k-1,RhoTheta_comp));
+
+        Real qplus = 0.61* ( qv_data(i,j,k)-qv_d_ptr[k]) -
+                            (qc_data(i,j,k)-qc_d_ptr[k]+
+                             qi_data(i,j,k)-qi_d_ptr[k]+
+                             cell_prim(i,j,k,PrimQp_comp)-qp_d_ptr[k])
+                   + (tempp3d-tempp1d)/tempp1d*(Real(1.0) + Real(0.61)*qv_d_ptr[k]-qc_d_ptr[k]-qi_d_ptr[k]-qp_d_ptr[k]);
+
+        Real qminus = 0.61 *( qv_data(i,j,k-1)-qv_d_ptr[k-1]) -
+                             (qc_data(i,j,k-1)-qc_d_ptr[k-1]+
+                              qi_data(i,j,k-1)-qi_d_ptr[k-1]+
+                              cell_prim(i,j,k-1,PrimQp_comp)-qp_d_ptr[k-1])
+                   + (tempm3d-tempm1d)/tempm1d*(Real(1.0) + Real(0.61)*qv_d_ptr[k-1]-qi_d_ptr[k-1]-qc_d_ptr[k-1]-qp_d_ptr[k-1]);
+
+        Real qavg  = Real(0.5) * (qplus + qminus);
+        Real r0avg = Real(0.5) * (r0_arr(i,j,k) + r0_arr(i,j,k-1));
+
+        rhs -= qavg * r0avg * grav_gpu[2];
+        amrex::ignore_unused(l_anelastic, p0_arr);
+#else
+        rhs -= gpz;
+
+        // Buoyancy
+        if (l_anelastic) {
+            Real theta0_hi = getRhoThetagivenP(p0_arr(i,j,k  )) / r0_arr(i,j,k  );
+            Real theta0_lo = getRhoThetagivenP(p0_arr(i,j,k-1)) / r0_arr(i,j,k-1);
+            Real thetap_hi = cell_prim(i,j,k  ,PrimTheta_comp) / theta0_hi - 1.0;
+            Real thetap_lo = cell_prim(i,j,k-1,PrimTheta_comp) / theta0_lo - 1.0;
+            rhs -= grav_gpu[2] * 0.5 * ( r0_arr(i,j,k  ) * thetap_hi
+                                       + r0_arr(i,j,k-1) * thetap_lo );
+        } else {
+            rhs += grav_gpu[2] * 0.5 * ( cell_data(i,j,k) + cell_data(i,j,k-1)
+                                       - r0_arr(i,j,k) -    r0_arr(i,j,k-1) );
+        }
+#endif
+        rhs += ext_forcing[2];
+
+        if (l_use_coriolis) {
+            Real rho_u_loc = 0.25 * (rho_u(i+1,j,k) + rho_u(i,j,k) + rho_u(i+1,j,k-1) + rho_u(i,j,k-1));
+            rhs += coriolis_factor * rho_u_loc * cosphi;
+        }
+
+        if (l_use_rayleigh) {
+            rhs -= rayleigh_tau[k] * rho_w(i,j,k);
+        }
+
+        rho_w_rhs(i,j,k) = rhs;
+    });
+}
+
+namespace {
+struct SelectFusedMomRHS_N {
+    // There is no fused path with terrain
+    template <int order, bool use_terrain, bool use_mf>
+    static FusedMomRHSFn get () { return use_terrain ? nullptr : &FusedMomRHS_N<order,use_mf>; }
+};
+}
+
+FusedMomRHSFn
+select_FusedMomRHS_N (int spatial_order, bool use_mf)
+{
+    return select_advection_kernel<SelectFusedMomRHS_N>(spatial_order, false, use_mf);
+}
@@ -0,0 +1,168 @@
+#include <IndexDefines.H>
+#include <Advection.H>
+#include <Diffusion.H>
+#include <Interpolation.H>
+#include <TimeIntegration.H>
+
+using namespace amrex;
+
+/**
+ * Slow RHS of the cell-centered variables n_start .. n_end without terrain, in a single pass
+ *
+ * For every cell the advective fluxes through the six faces, the diffusive fluxes (if diffuse)
+ * and the source terms are combined and the tendency is written once. This replaces, for these
+ * components, AdvectionSrcForRhoAndTheta or AdvectionSrcForScalars followed by
+ * DiffusionSrcForState_N (and the Rayleigh damping of theta), without storing the diffusive
+ * fluxes and without reading the primitive variables and the tendency again. The arithmetic is
+ * the same as on the split path, term by term.
+ *
+ * with_rho: flux_x, flux_y and flux_z are rho_u, rho_v and Omega. The continuity tendency is
+ *           written as well, and the mass fluxes are accumulated into avg_xmom, avg_ymom and
+ *           avg_zmom as in AdvectionSrcForRhoAndTheta.
+ * otherwise: flux_x, flux_y and flux_z are the accumulated mass fluxes.
+ *
+ * The source terms are only added together with the diffusion, as on the split path.
+ */
+template <int order, bool use_mf, bool with_rho>
+void
+FusedScalarRHS_N (const Box& bx, const Box& valid_bx, int n_start, int n_end, bool diffuse,
+                  const Array4<const Real>& flux_x,
+                  const Array4<const Real>& flux_y,
+                  const Array4<const Real>& flux_z,
+                  const Array4<      Real>& avg_xmom,
+                  const Array4<      Real>& avg_ymom,
+                  const Array4<      Real>& avg_zmom,
+                  const Array4<const Real>& cell_data,
+                  const Array4<const Real>& cell_prim,
+                  const Array4<const Real>& source_fab,
+                  const Array4<      Real>& cell_rhs,
+                  const Array4<const Real>& mu_turb,
+                  const ScalarDiffusionCoeffs& coeffs,
+                  const GpuArray<Real, AMREX_SPACEDIM>& cellSizeInv,
+                  const Array4<const Real>& mf_m,
+                  const Array4<const Real>& mf_u,
+                  const Array4<const Real>& mf_v,
+                  const Real* rayleigh_tau, const Real* rayleigh_thetabar)
+{
+    BL_PROFILE_VAR("FusedScalarRHS_N()", FusedScalarRHS_N);
+    auto dxInv = cellSizeInv[0], dyInv = cellSizeInv[1], dzInv = cellSizeInv[2];
+
+    const auto& vbx_hi = amrex::ubound(valid_bx);
+
+    const bool l_consA = coeffs.rho_weighted;
+    const bool l_turb  = coeffs.use_turb;
+    const GpuArray<Real,NUM_PRIM> alpha_eff = coeffs.alpha_eff;
+    const GpuArray<int ,NUM_PRIM> idx_h     = coeffs.eddy_diff_idx_h;
+    const GpuArray<int ,NUM_PRIM> idx_v     = coeffs.eddy_diff_idx_v;
+
+    const bool l_rayleigh = (rayleigh_tau != nullptr);
+
+    amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+    {
+        Real xflux_lo, xflux_hi, yflux_lo, yflux_hi;
+        if (with_rho) {
+            xflux_lo = use_mf ? flux_x(i  ,j,k) / mf_u(i  ,j  ,0) : flux_x(i  ,j,k);
+            xflux_hi = use_mf ? flux_x(i+1,j,k) / mf_u(i+1,j  ,0) : flux_x(i+1,j,k);
+            yflux_lo = use_mf ? flux_y(i,j  ,k) / mf_v(i  ,j  ,0) : flux_y(i,j  ,k);
+            yflux_hi = use_mf ? flux_y(i,j+1,k) / mf_v(i  ,j+1,0) : flux_y(i,j+1,k);
+        } else {
+            xflux_lo = flux_x(i  ,j,k);
+            xflux_hi = flux_x(i+1,j,k);
+            yflux_lo = flux_y(i,j  ,k);
+            yflux_hi = flux_y(i,j+1,k);
+        }
+        Real zflux_lo = flux_z(i,j,k  );
+        Real zflux_hi = flux_z(i,j,k+1);
+
+        Real mfsq = use_mf ? mf_m(i,j,0) * mf_m(i,j,0) : 1.;
+
+        if (with_rho) {
+            avg_xmom(i  ,j,k) += xflux_lo;
+            if (i == vbx_hi.x)
+                avg_xmom(i+1,j,k) += xflux_hi;
+            avg_ymom(i,j  ,k) += yflux_lo;
+            if (j == vbx_hi.y)
+                avg_ymom(i,j+1,k) += yflux_hi;
+            avg_zmom(i,j,k  ) += zflux_lo;
+            if (k == vbx_hi.z)
+                avg_zmom(i,j,k+1) += zflux_hi;
+
+            cell_rhs(i,j,k,Rho_comp) = - (
+                ( xflux_hi - xflux_lo ) * dxInv * mfsq +
+                ( yflux_hi - yflux_lo ) * dyInv * mfsq +
+                ( zflux_hi - zflux_lo ) * dzInv);
+        }
+
+        for (int n = n_start; n <= n_end; ++n)
+        {
+            const int prim_index = n - 1;
+
+            Real rhs = - (
+                ( xflux_hi * InterpolateInX<order>(i+1,j  ,k  ,cell_prim,prim_index,xflux_hi) -
+                  xflux_lo * InterpolateInX<order>(i  ,j  ,k  ,cell_prim,prim_index,xflux_lo) ) * dxInv * mfsq +
+                ( yflux_hi * InterpolateInY<order>(i  ,j+1,k  ,cell_prim,prim_index,yflux_hi) -
+                  yflux_lo * InterpolateInY<order>(i  ,j  ,k  ,cell_prim,prim_index,yflux_lo) ) * dyInv * mfsq +
+                ( zflux_hi * InterpolateInZ<order>(i  ,j  ,k+1,cell_prim,prim_index,zflux_hi) -
+                  zflux_lo * InterpolateInZ<order>(i  ,j  ,k  ,cell_prim,prim_index,zflux_lo) ) * dzInv);
+
+            if (diffuse) {
+                const Real alpha = alpha_eff[prim_index];
+                const int  ih    = idx_h[prim_index];
+                const int  iv    = idx_v[prim_index];
+
+                // Diffusion coefficient at the face between the cells (ii,jj,kk) and (i,j,k)
+                auto coef = [=] (int ii, int jj, int kk, int ieddy) noexcept -> Real
+                {
+                    Real c = alpha;
+                    if (l_consA) c *= 0.5 * ( cell_data(i, j, k, Rho_comp) + cell_data(ii, jj, kk, Rho_comp) );
+                    if (l_turb)  c += 0.5 * ( mu_turb(i, j, k, ieddy) + mu_turb(ii, jj, kk, ieddy) );
+                    return c;
+                };
+
+                const Real q = cell_prim(i,j,k,prim_index);
+
+                Real dflux_x_lo = coef(i-1,j,k,ih) * (q - cell_prim(i-1,j,k,prim_index)) * dxInv * mf_u(i  ,j,0);
+                Real dflux_x_hi = coef(i+1,j,k,ih) * (cell_prim(i+1,j,k,prim_index) - q) * dxInv * mf_u(i+1,j,0);
+                Real dflux_y_lo = coef(i,j-1,k,ih) * (q - cell_prim(i,j-1,k,prim_index)) * dyInv * mf_v(i,j  ,0);
+                Real dflux_y_hi = coef(i,j+1,k,ih) * (cell_prim(i,j+1,k,prim_index) - q) * dyInv * mf_v(i,j+1,0);
+                Real dflux_z_lo = coef(i,j,k-1,iv) * (q - cell_prim(i,j,k-1,prim_index)) * dzInv;
+                Real dflux_z_hi = coef(i,j,k+1,iv) * (cell_prim(i,j,k+1,prim_index) - q) * dzInv;
+
+                rhs += (dflux_x_hi - dflux_x_lo) * dxInv * mf_m(i,j,0)
+                      +(dflux_y_hi - dflux_y_lo) * dyInv * mf_m(i,j,0)
+                      +(dflux_z_hi - dflux_z_lo) * dzInv;
+
+                rhs += source_fab(i,j,k,n);
+            }
+
+            if (l_rayleigh && n == RhoTheta_comp) {
+                rhs -= rayleigh_tau[k] * (cell_prim(i,j,k,PrimTheta_comp) - rayleigh_thetabar[k]) * cell_data(i,j,k,Rho_comp);
+            }
+
+            cell_rhs(i,j,k,n) = rhs;
+        }
+    });
+}
+
+namespace {
+struct SelectFusedScalarRHS_N {
+    // There is no fused path with terrain
+    template <int order, bool use_terrain, bool use_mf>
+    static FusedScalarRHSFn get () { return use_terrain ? nullptr : &FusedScalarRHS_N<order,use_mf,false>; }
+};
+
+struct SelectFusedRhoThetaRHS_N {
+    template <int order, bool use_terrain, bool use_mf>
+    static FusedScalarRHSFn get () { return use_terrain ? nullptr : &FusedScalarRHS_N<order,use_mf,true>; }
+};
+}
+
+FusedScalarRHSFn
+select_FusedScalarRHS_N (int spatial_order, bool use_mf, bool with_rho)
+{
+    if (with_rho) {
+        return select_advection_kernel<SelectFusedRhoThetaRHS_N>(spatial_order, false, use_mf);
+    } else {
+        return select_advection_kernel<SelectFusedScalarRHS_N>(spatial_order, false, use_mf);
+    }
+}
@@ -8,7 +8,7 @@ using namespace amrex;
 
 void make_fast_coeffs (int /*level*/,
                        BoxArray& grids_to_evolve,
-                       MultiFab& fast_coeffs,
+                       FastMultiFab& fast_coeffs,
                        Vector<MultiFab>& S_stage_data,                 // S_bar = S^n, S^* or S^**
                        const MultiFab& S_stage_prim,
                        const MultiFab& pi_stage,                       // Exner function evaluted at least stage
@@ -34,11 +34,12 @@ void make_fast_coeffs (int /*level*/,
 
     Real dzi = dxInv[2];
 
-    MultiFab coeff_A_mf(fast_coeffs, amrex::make_alias, 0, 1);
-    MultiFab coeff_B_mf(fast_coeffs, amrex::make_alias, 1, 1);
-    MultiFab coeff_C_mf(fast_coeffs, amrex::make_alias, 2, 1);
-    MultiFab coeff_P_mf(fast_coeffs, amrex::make_alias, 3, 1);
-    MultiFab coeff_Q_mf(fast_coeffs, amrex::make_alias, 4, 1);
+    // The coefficients are computed in Real and stored as FastReal
+    FastMultiFab coeff_A_mf(fast_coeffs, amrex::make_alias, 0, 1);
+    FastMultiFab coeff_B_mf(fast_coeffs, amrex::make_alias, 1, 1);
+    FastMultiFab coeff_C_mf(fast_coeffs, amrex::make_alias, 2, 1);
+    FastMultiFab coeff_P_mf(fast_coeffs, amrex::make_alias, 3, 1);
+    FastMultiFab coeff_Q_mf(fast_coeffs, amrex::make_alias, 4, 1);
 
     FArrayBox gam_fab;
 
@@ -249,12 +250,15 @@ void make_fast_coeffs (int /*level*/,
 #endif
         } // end profile
 
-        // In the end we save the inverse of the diagonal (B) coefficient
+        // In the end we save the inverse of the diagonal (B) coefficient and replace C
+        //    by the upper multiplier C/B so that the substeps only need to substitute
+        //    (see fast_tridiagonal_solve). Note that at the bottom and top faces B = 1 and C = 0.
         {
         BL_PROFILE("make_coeffs_invert");
             ParallelFor(bx_shrunk_in_k, [=] AMREX_GPU_DEVICE (int i, int j, int k)
             {
                 coeffB_a(i,j,k) = 1.0 / coeffB_a(i,j,k);
+                coeffC_a(i,j,k) *= coeffB_a(i,j,k);
             });
         } // end profile
     } // mfi
@@ -34,6 +34,7 @@ void erf_slow_rhs_post (int /*level*/, Real dt,
                         std::unique_ptr<MultiFab>& z_phys_nd,
                         std::unique_ptr<MultiFab>& dJ,
                         std::unique_ptr<MultiFab>& dJ_new,
+                        const Vector<MultiFab>& face_met,
                         std::unique_ptr<MultiFab>& mapfac_m,
                         std::unique_ptr<MultiFab>& mapfac_u,
                         std::unique_ptr<MultiFab>& mapfac_v)
@@ -43,11 +44,22 @@ void erf_slow_rhs_post (int /*level*/, Real dt,
     const MultiFab* t_mean_mf = nullptr;
     if (most) t_mean_mf = most->get_mac_avg(0,2);
 
-    const int  l_spatial_order  = solverChoice.spatial_order;
     const bool l_use_terrain    = solverChoice.use_terrain;
     const bool l_moving_terrain = (solverChoice.terrain_type == 1);
     if (l_moving_terrain) AMREX_ALWAYS_ASSERT(l_use_terrain);
 
+    // Are the metric terms on the faces stored (see make_face_metrics)?
+    const bool l_use_met_cache  = l_use_terrain && !face_met.empty();
+
+    // Scalar advection kernel specialized for this spatial order, terrain and map factor choice
+    const AdvectionSrcForScalarsFn advection_scalars = select_advection_kernels(solverChoice).scalars;
+
+    // Advection, diffusion and sources of the scalars in a single pass (no terrain only)
+    const bool l_fused_scalar = solverChoice.use_fused_scalar_rhs && !l_use_terrain;
+    const FusedScalarRHSFn fused_scalars = l_fused_scalar ?
+        select_FusedScalarRHS_N(solverChoice.spatial_order, solverChoice.use_mapfactor, false) : nullptr;
+    const ScalarDiffusionCoeffs diff_coeffs = make_scalar_diffusion_coeffs(solverChoice);
+
     const bool l_use_QKE        = solverChoice.use_QKE && solverChoice.advect_QKE;
     const bool l_use_deardorff  = (solverChoice.les_type == LESType::Deardorff);
     const bool l_use_diff       = ( (solverChoice.molec_diff_type != MolecDiffType::None) ||
@@ -79,7 +91,7 @@ void erf_slow_rhs_post (int /*level*/, Real dt,
     MultiFab* dflux_y = nullptr;
     MultiFab* dflux_z = nullptr;
 
-    if (l_use_diff) {
+    if (l_use_diff && !l_fused_scalar) {
         dflux_x = new MultiFab(convert(ba,IntVect(1,0,0)), dm, nvars, 0);
         dflux_y = new MultiFab(convert(ba,IntVect(0,1,0)), dm, nvars, 0);
         dflux_z = new MultiFab(convert(ba,IntVect(0,0,1)), dm, nvars, 0);
@@ -137,6 +149,11 @@ void erf_slow_rhs_post (int /*level*/, Real dt,
         const Array4<const Real>& detJ     = l_use_terrain    ? dJ->const_array(mfi)        : Array4<const Real>{};
         const Array4<const Real>& detJ_new = l_moving_terrain ? dJ_new->const_array(mfi)    : Array4<const Real>{};
 
+        // Cached metric terms on the faces, or empty arrays if we compute them from z_nd
+        const Array4<const Real>& met_x    = l_use_met_cache  ? face_met[0].const_array(mfi) : Array4<const Real>{};
+        const Array4<const Real>& met_y    = l_use_met_cache  ? face_met[1].const_array(mfi) : Array4<const Real>{};
+        const Array4<const Real>& met_z    = l_use_met_cache  ? face_met[2].const_array(mfi) : Array4<const Real>{};
+
         // Map factors
         const Array4<const Real>& mf_m = mapfac_m->const_array(mfi);
         const Array4<const Real>& mf_u = mapfac_u->const_array(mfi);
@@ -162,52 +179,73 @@ void erf_slow_rhs_post (int /*level*/, Real dt,
         // **************************************************************************
         // Define updates in the RHS of continuity, temperature, and scalar equations
         // **************************************************************************
-        if (l_use_deardorff) {
-            int start_comp = RhoKE_comp;
-            int   num_comp = 1;
-            AdvectionSrcForScalars(bx, start_comp, num_comp, avg_xmom, avg_ymom, avg_zmom,
-                                   cur_prim, cell_rhs, detJ,
-                                   dxInv, mf_m, l_spatial_order, l_use_terrain);
-        }
-        if (l_use_QKE) {
-            int start_comp = RhoQKE_comp;
-            int   num_comp = 1;
-            AdvectionSrcForScalars(bx, start_comp, num_comp, avg_xmom, avg_ymom, avg_zmom,
-                                   cur_prim, cell_rhs, detJ,
-                                   dxInv, mf_m, l_spatial_order, l_use_terrain);
-        }
         int start_comp = RhoScalar_comp;
         int   num_comp = S_data[IntVar::cons].nComp() - start_comp;
-        AdvectionSrcForScalars(bx, start_comp, num_comp, avg_xmom, avg_ymom, avg_zmom,
-                               cur_prim, cell_rhs, detJ,
-                               dxInv, mf_m, l_spatial_order, l_use_terrain);
-
-        if (l_use_diff) {
-            Array4<Real> diffflux_x = dflux_x->array(mfi);
-            Array4<Real> diffflux_y = dflux_y->array(mfi);
-            Array4<Real> diffflux_z = dflux_z->array(mfi);
-
-            const Array4<const Real> tm_arr = t_mean_mf ? t_mean_mf->const_array(mfi) : Array4<const Real>{};
-
-            // NOTE: No diffusion for continuity, so n starts at 1.
-            //       KE calls moved inside DiffSrcForState.
-            int n_start = amrex::max(start_comp,RhoTheta_comp);
-            int n_end   = start_comp + num_comp - 1;
-
-            if (l_use_terrain) {
-                DiffusionSrcForState_T(bx, domain, n_start, n_end, u, v, w,
-                                       cur_cons, cur_prim, source_fab, cell_rhs,
-                                       diffflux_x, diffflux_y, diffflux_z, z_nd, detJ,
-                                       dxInv, mf_m, mf_u, mf_v,
-                                       mu_turb, solverChoice, tm_arr, grav_gpu, bc_ptr);
-            } else {
-                DiffusionSrcForState_N(bx, domain, n_start, n_end, u, v, w,
-                                       cur_cons, cur_prim, source_fab, cell_rhs,
-                                       diffflux_x, diffflux_y, diffflux_z,
-                                       dxInv, mf_m, mf_u, mf_v,
-                                       mu_turb, solverChoice, tm_arr, grav_gpu, bc_ptr);
+
+        if (l_fused_scalar) {
+            // KE and QKE are advected only; the sources of KE and QKE follow the scalars
+            if (l_use_deardorff) {
+                fused_scalars(bx, bx, RhoKE_comp, RhoKE_comp, false,
+                              avg_xmom, avg_ymom, avg_zmom, avg_xmom, avg_ymom, avg_zmom,
+                              cur_cons, cur_prim, source_fab, cell_rhs, mu_turb, diff_coeffs,
+                              dxInv, mf_m, mf_u, mf_v, nullptr, nullptr);
             }
-        }
+            if (l_use_QKE) {
+                fused_scalars(bx, bx, RhoQKE_comp, RhoQKE_comp, false,
+                              avg_xmom, avg_ymom, avg_zmom, avg_xmom, avg_ymom, avg_zmom,
+                              cur_cons, cur_prim, source_fab, cell_rhs, mu_turb, diff_coeffs,
+                              dxInv, mf_m, mf_u, mf_v, nullptr, nullptr);
+            }
+            fused_scalars(bx, bx, start_comp, start_comp + num_comp - 1, l_use_diff,
+                          avg_xmom, avg_ymom, avg_zmom, avg_xmom, avg_ymom, avg_zmom,
+                          cur_cons, cur_prim, source_fab, cell_rhs, mu_turb, diff_coeffs,
+                          dxInv, mf_m, mf_u, mf_v, nullptr, nullptr);
+
+            if (l_use_diff) {
+                const Array4<const Real> tm_arr = t_mean_mf ? t_mean_mf->const_array(mfi) : Array4<const Real>{};
+                TKESrc_N(bx, domain, nvars-1, u, v, w, cur_cons, cur_prim, cell_rhs,
+                         dxInv, mu_turb, solverChoice, tm_arr, grav_gpu, bc_ptr);
+            }
+        } else {
+            if (l_use_deardorff) {
+                advection_scalars(bx, RhoKE_comp, 1, avg_xmom, avg_ymom, avg_zmom,
+                                  cur_prim, cell_rhs, detJ, dxInv, mf_m);
+            }
+            if (l_use_QKE) {
+                advection_scalars(bx, RhoQKE_comp, 1, avg_xmom, avg_ymom, avg_zmom,
+                                  cur_prim, cell_rhs, detJ, dxInv, mf_m);
+            }
+            advection_scalars(bx, start_comp, num_comp, avg_xmom, avg_ymom, avg_zmom,
+                              cur_prim, cell_rhs, detJ, dxInv, mf_m);
+
+            if (l_use_diff) {
+                Array4<Real> diffflux_x = dflux_x->array(mfi);
+                Array4<Real> diffflux_y = dflux_y->array(mfi);
+                Array4<Real> diffflux_z = dflux_z->array(mfi);
+
+                const Array4<const Real> tm_arr = t_mean_mf ? t_mean_mf->const_array(mfi) : Array4<const Real>{};
+
+                // NOTE: No diffusion for continuity, so n starts at 1.
+                //       KE calls moved inside DiffSrcForState.
+                int n_start = amrex::max(start_comp,RhoTheta_comp);
+                int n_end   = start_comp + num_comp - 1;
+
+                if (l_use_terrain) {
+                    DiffusionSrcForState_T(bx, domain, n_start, n_end, u, v, w,
+                                           cur_cons, cur_prim, source_fab, cell_rhs,
+                                           diffflux_x, diffflux_y, diffflux_z,
+                                           z_nd, detJ, met_x, met_y, met_z,
+                                           dxInv, mf_m, mf_u, mf_v,
+                                           mu_turb, solverChoice, tm_arr, grav_gpu, bc_ptr);
+                } else {
+                    DiffusionSrcForState_N(bx, domain, n_start, n_end, u, v, w,
+                                           cur_cons, cur_prim, source_fab, cell_rhs,
+                                           diffflux_x, diffflux_y, diffflux_z,
+                                           dxInv, mf_m, mf_u, mf_v,
+                                           mu_turb, solverChoice, tm_arr, grav_gpu, bc_ptr);
+                }
+            }
+        } // l_fused_scalar
 
         // This updates just the "slow" conserved variables
         {
@@ -259,7 +297,7 @@ void erf_slow_rhs_post (int /*level*/, Real dt,
         } // end profile
     } // mfi
 
-    if (l_use_diff) {
+    if (l_use_diff && !l_fused_scalar) {
         delete dflux_x;
         delete dflux_y;
         delete dflux_z;
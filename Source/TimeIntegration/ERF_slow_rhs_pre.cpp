@@ -42,7 +42,8 @@ void erf_slow_rhs_pre (int /*level*/, int nrk,
                        const Gpu::DeviceVector<amrex::BCRec> domain_bcs_type_d,
                        const Vector<amrex::BCRec> domain_bcs_type,
                        std::unique_ptr<MultiFab>& z_phys_nd, std::unique_ptr<MultiFab>& dJ,
-                       const MultiFab* r0, const MultiFab* p0,
+                       const Vector<MultiFab>& face_met,
+                       const MultiFab* r0, const MultiFab* p0, const MultiFab* pp_inc,
                        std::unique_ptr<MultiFab>& mapfac_m,
                        std::unique_ptr<MultiFab>& mapfac_u,
                        std::unique_ptr<MultiFab>& mapfac_v,
@@ -57,11 +58,30 @@ void erf_slow_rhs_pre (int /*level*/, int nrk,
     int start_comp = 0;
     int   num_comp = 2;
 
-    const int  l_spatial_order  = solverChoice.spatial_order;
     const bool l_use_terrain    = solverChoice.use_terrain;
     const bool l_moving_terrain = (solverChoice.terrain_type == 1);
     if (l_moving_terrain) AMREX_ALWAYS_ASSERT (l_use_terrain);
 
+    // Are the metric terms on the faces stored (see make_face_metrics)?
+    const bool l_use_met_cache  = l_use_terrain && !face_met.empty();
+
+    const bool l_anelastic      = solverChoice.anelastic;
+    if (l_anelastic) AMREX_ALWAYS_ASSERT (pp_inc && !l_use_terrain);
+
+    // Advection kernels specialized for this spatial order, terrain and map factor choice
+    const AdvectionKernels advection = select_advection_kernels(solverChoice);
+
+    // Advection, diffusion and sources of rho and (rho theta) in a single pass (no terrain only)
+    const bool l_fused_scalar = solverChoice.use_fused_scalar_rhs && !l_use_terrain;
+    const FusedScalarRHSFn fused_rho_and_theta = l_fused_scalar ?
+        select_FusedScalarRHS_N(solverChoice.spatial_order, solverChoice.use_mapfactor, true) : nullptr;
+    const ScalarDiffusionCoeffs diff_coeffs = make_scalar_diffusion_coeffs(solverChoice);
+
+    // Advection, diffusion and forcing of the momenta in a single pass over the faces (no terrain only)
+    const bool l_fused_mom = solverChoice.use_fused_mom_rhs && !l_use_terrain;
+    const FusedMomRHSFn fused_mom = l_fused_mom ?
+        select_FusedMomRHS_N(solverChoice.spatial_order, solverChoice.use_mapfactor) : nullptr;
+
     bool       l_use_diff       = ( (solverChoice.molec_diff_type != MolecDiffType::None) ||
                                     (solverChoice.les_type        !=       LESType::None) ||
                                     (solverChoice.pbl_type        !=       PBLType::None) );
@@ -71,6 +91,9 @@ void erf_slow_rhs_pre (int /*level*/, int nrk,
                                     solverChoice.les_type == LESType::Deardorff   ||
                                     solverChoice.pbl_type == PBLType::MYNN25 );
 
+    // The strain and stress are only kept per tile (erf.use_tiled_stress)
+    const bool l_tiled_stress   = l_use_diff && (Tau11 == nullptr);
+
     const amrex::BCRec* bc_ptr   = domain_bcs_type_d.data();
     const amrex::BCRec* bc_ptr_h = domain_bcs_type.data();
 
@@ -141,6 +164,33 @@ void erf_slow_rhs_pre (int /*level*/, int nrk,
        -solverChoice.abl_pressure_grad[1] + solverChoice.abl_geo_forcing[1],
        -solverChoice.abl_pressure_grad[2] + solverChoice.abl_geo_forcing[2]};
 
+    MomentumForcing mom_forcing;
+    if (l_fused_mom) {
+        mom_forcing.ext_forcing     = ext_forcing;
+        mom_forcing.grav            = grav_gpu;
+        mom_forcing.use_diff        = l_use_diff;
+        mom_forcing.rho_weighted    = (solverChoice.molec_diff_type == MolecDiffType::ConstantAlpha);
+        mom_forcing.rho0_trans      = solverChoice.rho0_trans;
+        mom_forcing.use_coriolis    = solverChoice.use_coriolis;
+        mom_forcing.coriolis_factor = solverChoice.coriolis_factor;
+        mom_forcing.sinphi          = solverChoice.sinphi;
+        mom_forcing.cosphi          = solverChoice.cosphi;
+        if (solverChoice.use_rayleigh_damping) {
+            mom_forcing.rayleigh_tau  = dptr_rayleigh_tau;
+            mom_forcing.rayleigh_ubar = dptr_rayleigh_ubar;
+            mom_forcing.rayleigh_vbar = dptr_rayleigh_vbar;
+        }
+        mom_forcing.anelastic       = l_anelastic;
+#ifdef ERF_USE_MOISTURE
+        mom_forcing.rho_d           = rho_d_ptr;
+        mom_forcing.theta_d         = theta_d_ptr;
+        mom_forcing.qv_d            = qv_d_ptr;
+        mom_forcing.qc_d            = qc_d_ptr;
+        mom_forcing.qi_d            = qi_d_ptr;
+        mom_forcing.qp_d            = qp_d_ptr;
+#endif
+    }
+
     // *************************************************************************
     // Pre-computed quantities
     // *************************************************************************
@@ -157,6 +207,8 @@ void erf_slow_rhs_pre (int /*level*/, int nrk,
 
     if (l_use_diff) {
         expr    = new MultiFab(ba  , dm, 1, IntVect(1,1,0));
+    }
+    if (l_use_diff && !l_fused_scalar) {
         dflux_x = new MultiFab(convert(ba,IntVect(1,0,0)), dm, nvars, 0);
         dflux_y = new MultiFab(convert(ba,IntVect(0,1,0)), dm, nvars, 0);
         dflux_z = new MultiFab(convert(ba,IntVect(0,0,1)), dm, nvars, 0);
@@ -168,6 +220,11 @@ void erf_slow_rhs_pre (int /*level*/, int nrk,
 #ifdef _OPENMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
+    {
+
+    // Strain and stress of the current tile if they are not stored at level scope
+    FArrayBox tau_fab;
+
     for ( MFIter mfi(S_data[IntVar::cons],TilingIfNotGPU()); mfi.isValid(); ++mfi)
     {
         const Box& valid_bx = grids_to_evolve[mfi.index()];
@@ -233,6 +290,11 @@ void erf_slow_rhs_pre (int /*level*/, int nrk,
         const Array4<const Real>& z_nd   = l_use_terrain ? z_phys_nd->const_array(mfi) : Array4<const Real>{};
         const Array4<const Real>& detJ   = l_use_terrain ?        dJ->const_array(mfi) : Array4<const Real>{};
 
+        // Cached metric terms on the faces, or empty arrays if we compute them from z_nd
+        const Array4<const Real>& met_x  = l_use_met_cache ? face_met[0].const_array(mfi) : Array4<const Real>{};
+        const Array4<const Real>& met_y  = l_use_met_cache ? face_met[1].const_array(mfi) : Array4<const Real>{};
+        const Array4<const Real>& met_z  = l_use_met_cache ? face_met[2].const_array(mfi) : Array4<const Real>{};
+
         // Base state
         const Array4<const Real>& r0_arr = r0->const_array(mfi);
         const Array4<const Real>& p0_arr = p0->const_array(mfi);
@@ -241,12 +303,20 @@ void erf_slow_rhs_pre (int /*level*/, int nrk,
         const Array4<Real> & pp_arr  = pprime.array(mfi);
         {
         BL_PROFILE("slow_rhs_pre_pprime");
-        amrex::ParallelFor(gbx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept {
-            //if (cell_data(i,j,k,RhoTheta_comp) < 0.) printf("BAD THETA AT %d %d %d %e %e \n",
-            //    i,j,k,cell_data(i,j,k,RhoTheta_comp),cell_data(i,j,k+1,RhoTheta_comp));
-            AMREX_ASSERT(cell_data(i,j,k,RhoTheta_comp) > 0.);
-            pp_arr(i,j,k) = getPgivenRTh(cell_data(i,j,k,RhoTheta_comp)) - p0_arr(i,j,k);
-        });
+        if (l_anelastic) {
+            // The pressure is not a function of the state but comes from the projections
+            const Array4<const Real>& pp_inc_arr = pp_inc->const_array(mfi);
+            amrex::ParallelFor(gbx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept {
+                pp_arr(i,j,k) = pp_inc_arr(i,j,k);
+            });
+        } else {
+            amrex::ParallelFor(gbx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept {
+                //if (cell_data(i,j,k,RhoTheta_comp) < 0.) printf("BAD THETA AT %d %d %d %e %e \n",
+                //    i,j,k,cell_data(i,j,k,RhoTheta_comp),cell_data(i,j,k+1,RhoTheta_comp));
+                AMREX_ASSERT(cell_data(i,j,k,RhoTheta_comp) > 0.);
+                pp_arr(i,j,k) = getPgivenRTh(cell_data(i,j,k,RhoTheta_comp)) - p0_arr(i,j,k);
+            });
+        }
         } // end profile
 
         Array4<Real> er_arr;
@@ -269,11 +339,11 @@ void erf_slow_rhs_pre (int /*level*/, int nrk,
 
                 amrex::ParallelFor(gbx2, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept {
 
-                    Real met_u_h_zeta_hi = Compute_h_zeta_AtIface(i+1, j  , k, dxInv, z_nd);
-                    Real met_u_h_zeta_lo = Compute_h_zeta_AtIface(i  , j  , k, dxInv, z_nd);
+                    Real met_u_h_zeta_hi = Get_h_zeta_AtIface(i+1, j  , k, dxInv, z_nd, met_x);
+                    Real met_u_h_zeta_lo = Get_h_zeta_AtIface(i  , j  , k, dxInv, z_nd, met_x);
 
-                    Real met_v_h_zeta_hi = Compute_h_zeta_AtJface(i  , j+1, k, dxInv, z_nd);
-                    Real met_v_h_zeta_lo = Compute_h_zeta_AtJface(i  , j  , k, dxInv, z_nd);
+                    Real met_v_h_zeta_hi = Get_h_zeta_AtJface(i  , j+1, k, dxInv, z_nd, met_y);
+                    Real met_v_h_zeta_lo = Get_h_zeta_AtJface(i  , j  , k, dxInv, z_nd, met_y);
 
                     Real Omega_hi = omega_arr(i,j,k+1);
                     Real Omega_lo = omega_arr(i,j,k  );
@@ -350,9 +420,16 @@ void erf_slow_rhs_pre (int /*level*/, int nrk,
             tau31 = Array4<Real>{};
             tau32 = Array4<Real>{};
         }
+        // Tiled stress: nothing is kept from TimeIntegration, so the strain is made here at every stage
+        Elixir tau_eli;
+        if (l_tiled_stress) {
+            ResizeTileStress(mfi.growntilebox(IntVect(1,1,0)), l_use_terrain, tau_fab,
+                             tau11, tau22, tau33, tau12, tau13, tau21, tau23, tau31, tau32);
+            tau_eli = tau_fab.elixir();
+        }
         {
         BL_PROFILE("slow_rhs_making_strain");
-        if (nrk>0 && l_use_diff) {
+        if ((nrk>0 || l_tiled_stress) && l_use_diff) {
             Box bxcc  = mfi.growntilebox(IntVect(1,1,0));
             Box tbxxy = bx; tbxxy.convert(IntVect(1,1,0));
             Box tbxxz = bx; tbxxz.convert(IntVect(1,0,1));
@@ -486,50 +563,62 @@ void erf_slow_rhs_pre (int /*level*/, int nrk,
         // **************************************************************************
         Real fac = 1.0;
 
-        AdvectionSrcForRhoAndTheta(bx, valid_bx, cell_rhs,       // these are being used to build the fluxes
-                                   rho_u, rho_v, omega_arr, fac,
-                                   avg_xmom, avg_ymom, avg_zmom, // these are being defined from the rho fluxes
-                                   cell_prim, z_nd, detJ,
-                                   dxInv, mf_m, mf_u, mf_v, l_spatial_order, l_use_terrain);
-
-        if (l_use_diff) {
-            Array4<Real> diffflux_x = dflux_x->array(mfi);
-            Array4<Real> diffflux_y = dflux_y->array(mfi);
-            Array4<Real> diffflux_z = dflux_z->array(mfi);;
-
-            const Array4<const Real> tm_arr = t_mean_mf ? t_mean_mf->const_array(mfi) : Array4<const Real>{};
-
-            // NOTE: No diffusion for continuity, so n starts at 1.
-            //       KE calls moved inside DiffSrcForState.
-            int n_start = amrex::max(start_comp,RhoTheta_comp);
-            int n_end   = start_comp + num_comp - 1;
-
-            if (l_use_terrain) {
-                DiffusionSrcForState_T(bx, domain, n_start, n_end, u, v, w,
-                                       cell_data, cell_prim, source_fab, cell_rhs,
-                                       diffflux_x, diffflux_y, diffflux_z, z_nd, detJ,
-                                       dxInv, mf_m, mf_u, mf_v,
-                                       mu_turb, solverChoice, tm_arr, grav_gpu, bc_ptr);
-            } else {
-                DiffusionSrcForState_N(bx, domain, n_start, n_end, u, v, w,
-                                       cell_data, cell_prim, source_fab, cell_rhs,
-                                       diffflux_x, diffflux_y, diffflux_z,
-                                       dxInv, mf_m, mf_u, mf_v,
-                                       mu_turb, solverChoice, tm_arr, grav_gpu, bc_ptr);
+        if (l_fused_scalar) {
+            // The diffusive fluxes of (rho theta) are not stored, and neither is the partial RHS
+            const Real* rayleigh_tau = solverChoice.use_rayleigh_damping ? dptr_rayleigh_tau : nullptr;
+            fused_rho_and_theta(bx, valid_bx, RhoTheta_comp, RhoTheta_comp, l_use_diff,
+                                rho_u, rho_v, omega_arr,
+                                avg_xmom, avg_ymom, avg_zmom,
+                                cell_data, cell_prim, source_fab, cell_rhs, mu_turb, diff_coeffs,
+                                dxInv, mf_m, mf_u, mf_v,
+                                rayleigh_tau, dptr_rayleigh_thetabar);
+        } else {
+            advection.rho_and_theta(bx, valid_bx, cell_rhs,       // these are being used to build the fluxes
+                                    rho_u, rho_v, omega_arr, fac,
+                                    avg_xmom, avg_ymom, avg_zmom, // these are being defined from the rho fluxes
+                                    cell_prim, z_nd, detJ, met_x, met_y,
+                                    dxInv, mf_m, mf_u, mf_v);
+
+            if (l_use_diff) {
+                Array4<Real> diffflux_x = dflux_x->array(mfi);
+                Array4<Real> diffflux_y = dflux_y->array(mfi);
+                Array4<Real> diffflux_z = dflux_z->array(mfi);;
+
+                const Array4<const Real> tm_arr = t_mean_mf ? t_mean_mf->const_array(mfi) : Array4<const Real>{};
+
+                // NOTE: No diffusion for continuity, so n starts at 1.
+                //       KE calls moved inside DiffSrcForState.
+                int n_start = amrex::max(start_comp,RhoTheta_comp);
+                int n_end   = start_comp + num_comp - 1;
+
+                if (l_use_terrain) {
+                    DiffusionSrcForState_T(bx, domain, n_start, n_end, u, v, w,
+                                           cell_data, cell_prim, source_fab, cell_rhs,
+                                           diffflux_x, diffflux_y, diffflux_z,
+                                           z_nd, detJ, met_x, met_y, met_z,
+                                           dxInv, mf_m, mf_u, mf_v,
+                                           mu_turb, solverChoice, tm_arr, grav_gpu, bc_ptr);
+                } else {
+                    DiffusionSrcForState_N(bx, domain, n_start, n_end, u, v, w,
+                                           cell_data, cell_prim, source_fab, cell_rhs,
+                                           diffflux_x, diffflux_y, diffflux_z,
+                                           dxInv, mf_m, mf_u, mf_v,
+                                           mu_turb, solverChoice, tm_arr, grav_gpu, bc_ptr);
+                }
             }
-        }
 
-        // Add Rayleigh damping
-        if (solverChoice.use_rayleigh_damping) {
-            int n  = RhoTheta_comp;
-            int nr = Rho_comp;
-            int np = PrimTheta_comp;
-            amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-            {
-                Real theta = cell_prim(i,j,k,np);
-                cell_rhs(i, j, k, n) -= dptr_rayleigh_tau[k] * (theta - dptr_rayleigh_thetabar[k]) * cell_data(i,j,k,nr);
-            });
-        }
+            // Add Rayleigh damping
+            if (solverChoice.use_rayleigh_damping) {
+                int n  = RhoTheta_comp;
+                int nr = Rho_comp;
+                int np = PrimTheta_comp;
+                amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                {
+                    Real theta = cell_prim(i,j,k,np);
+                    cell_rhs(i, j, k, n) -= dptr_rayleigh_tau[k] * (theta - dptr_rayleigh_thetabar[k]) * cell_data(i,j,k,nr);
+                });
+            }
+        } // l_fused_scalar
 
         // Multiply the slow RHS for rho and rhotheta by detJ here so we don't have to later
         if (l_use_terrain && l_moving_terrain) {
@@ -544,31 +633,47 @@ void erf_slow_rhs_pre (int /*level*/, int nrk,
         // Define updates in the RHS of {x, y, z}-momentum equations
         // *********************************************************************
 
-        AdvectionSrcForMom(tbx, tby, tbz,
-                           rho_u_rhs, rho_v_rhs, rho_w_rhs, u, v, w,
-                           rho_u    , rho_v    , omega_arr,
-                           z_nd, detJ, dxInv, mf_m, mf_u, mf_v,
-                           l_spatial_order, l_use_terrain, domhi_z);
-
-        if (l_use_diff) {
-            if (l_use_terrain) {
-                DiffusionSrcForMom_T(tbx, tby, tbz,
-                                     rho_u_rhs, rho_v_rhs, rho_w_rhs,
-                                     tau11, tau22, tau33,
-                                     tau12, tau13,
-                                     tau21, tau23,
-                                     tau31, tau32,
-                                     cell_data, detJ, solverChoice, dxInv,
-                                     mf_m, mf_u, mf_v);
-            } else {
-                DiffusionSrcForMom_N(tbx, tby, tbz,
-                                     rho_u_rhs, rho_v_rhs, rho_w_rhs,
-                                     tau11, tau22, tau33,
-                                     tau12, tau13, tau23,
-                                     cell_data, solverChoice, dxInv,
-                                     mf_m, mf_u, mf_v);
+        if (l_fused_mom) {
+            // The no-terrain loops over tbx, tby and tbz below are included in this pass
+            fused_mom(tbx, tby, tbz,
+                      rho_u_rhs, rho_v_rhs, rho_w_rhs, u, v, w,
+                      rho_u, rho_v, rho_w, omega_arr,
+                      tau11, tau22, tau33, tau12, tau13, tau23,
+                      cell_data, cell_prim, pp_arr, r0_arr, p0_arr,
+#ifdef ERF_USE_MOISTURE
+                      qv_data, qc_data, qi_data,
+#endif
+                      dxInv, mf_m, mf_u, mf_v, domhi_z, mom_forcing);
+        } else {
+            advection.mom(tbx, tby, tbz,
+                          rho_u_rhs, rho_v_rhs, rho_w_rhs, u, v, w,
+                          rho_u    , rho_v    , omega_arr,
+                          z_nd, detJ, met_x, met_y, met_z, dxInv, mf_m, mf_u, mf_v, domhi_z);
+
+            if (l_use_diff) {
+                if (l_use_terrain) {
+                    DiffusionSrcForMom_T(tbx, tby, tbz,
+                                         rho_u_rhs, rho_v_rhs, rho_w_rhs,
+                                         tau11, tau22, tau33,
+                                         tau12, tau13,
+                                         tau21, tau23,
+                                         tau31, tau32,
+                                         cell_data, detJ, met_x, met_y, met_z,
+                                         solverChoice, dxInv, mf_m, mf_u, mf_v);
+                } else {
+                    DiffusionSrcForMom_N(tbx, tby, tbz,
+                                         rho_u_rhs, rho_v_rhs, rho_w_rhs,
+                                         tau11, tau22, tau33,
+                                         tau12, tau13, tau23,
+                                         cell_data, solverChoice, dxInv,
+                                         mf_m, mf_u, mf_v);
+                    if (solverChoice.use_implicit_vert_diff) {
+                        SubtractVertDiffForMom_N(tbx, tby, domain, rho_u_rhs, rho_v_rhs,
+                                                 u, v, cell_data, mu_turb, solverChoice, dxInv);
+                    }
+                }
             }
-        }
+        } // l_fused_mom
 
         {
         BL_PROFILE("slow_rhs_pre_xmom");
@@ -582,8 +687,8 @@ void erf_slow_rhs_pre (int /*level*/, int nrk,
             // Add pressure gradient
             amrex::Real gpx;
 
-            Real met_h_xi   = Compute_h_xi_AtIface  (i, j, k, dxInv, z_nd);
-            Real met_h_zeta = Compute_h_zeta_AtIface(i, j, k, dxInv, z_nd);
+            Real met_h_xi   = Get_h_xi_AtIface  (i, j, k, dxInv, z_nd, met_x);
+            Real met_h_zeta = Get_h_zeta_AtIface(i, j, k, dxInv, z_nd, met_x);
 
             //Note : mx/my == 1, so no map factor needed here
             Real gp_xi = dxInv[0] * (pp_arr(i,j,k) - pp_arr(i-1,j,k));
@@ -635,7 +740,7 @@ void erf_slow_rhs_pre (int /*level*/, int nrk,
             }
         });
 
-        } else {
+        } else if (!l_fused_mom) {
         // ******************************************************************
         // NON-TERRAIN VERSION
         // ******************************************************************
@@ -685,8 +790,8 @@ void erf_slow_rhs_pre (int /*level*/, int nrk,
           [=] AMREX_GPU_DEVICE (int i, int j, int k)
           { // y-momentum equation
 
-              Real met_h_eta  = Compute_h_eta_AtJface (i, j, k, dxInv, z_nd);
-              Real met_h_zeta = Compute_h_zeta_AtJface(i, j, k, dxInv, z_nd);
+              Real met_h_eta  = Get_h_eta_AtJface (i, j, k, dxInv, z_nd, met_y);
+              Real met_h_zeta = Get_h_zeta_AtJface(i, j, k, dxInv, z_nd, met_y);
 
               //Note : mx/my == 1, so no map factor needed here
               Real gp_eta = dxInv[1] * (pp_arr(i,j,k) - pp_arr(i,j-1,k));
@@ -739,7 +844,7 @@ void erf_slow_rhs_pre (int /*level*/, int nrk,
         // ******************************************************************
         // NON-TERRAIN VERSION
         // ******************************************************************
-        } else {
+        } else if (!l_fused_mom) {
           amrex::ParallelFor(tby,
           [=] AMREX_GPU_DEVICE (int i, int j, int k)
           { // y-momentum equation
@@ -796,7 +901,7 @@ void erf_slow_rhs_pre (int /*level*/, int nrk,
           amrex::ParallelFor(tbz,
           [=] AMREX_GPU_DEVICE (int i, int j, int k) { // z-momentum equation
 
-                Real met_h_zeta = Compute_h_zeta_AtKface(i, j, k, dxInv, z_nd);
+                Real met_h_zeta = Get_h_zeta_AtKface(i, j, k, dxInv, z_nd, met_z);
                 Real gpz = dxInv[2] * ( pp_arr(i,j,k)-pp_arr(i,j,k-1) )  / met_h_zeta;
 
 #ifdef ERF_USE_MOISTURE
@@ -860,7 +965,7 @@ void erf_slow_rhs_pre (int /*level*/, int nrk,
         // ******************************************************************
         // NON-TERRAIN VERSION
         // ******************************************************************
-        } else {
+        } else if (!l_fused_mom) {
           amrex::ParallelFor(tbz,
           [=] AMREX_GPU_DEVICE (int i, int j, int k)
           { // z-momentum equation
@@ -899,8 +1004,18 @@ void erf_slow_rhs_pre (int /*level*/, int nrk,
 
                 rho_w_rhs(i, j, k) -= qavg * r0avg * grav_gpu[2];
 #else
-                rho_w_rhs(i, j, k) += grav_gpu[2] * 0.5 * ( cell_data(i,j,k) + cell_data(i,j,k-1)
-                                                             - r0_arr(i,j,k) -    r0_arr(i,j,k-1) );
+                if (l_anelastic) {
+                    // rho is held at its initial value, so the buoyancy comes from theta' / theta_0
+                    Real theta0_hi = getRhoThetagivenP(p0_arr(i,j,k  )) / r0_arr(i,j,k  );
+                    Real theta0_lo = getRhoThetagivenP(p0_arr(i,j,k-1)) / r0_arr(i,j,k-1);
+                    Real thetap_hi = cell_prim(i,j,k  ,PrimTheta_comp) / theta0_hi - 1.0;
+                    Real thetap_lo = cell_prim(i,j,k-1,PrimTheta_comp) / theta0_lo - 1.0;
+                    rho_w_rhs(i, j, k) -= grav_gpu[2] * 0.5 * ( r0_arr(i,j,k  ) * thetap_hi
+                                                               + r0_arr(i,j,k-1) * thetap_lo );
+                } else {
+                    rho_w_rhs(i, j, k) += grav_gpu[2] * 0.5 * ( cell_data(i,j,k) + cell_data(i,j,k-1)
+                                                                 - r0_arr(i,j,k) -    r0_arr(i,j,k-1) );
+                }
 #endif
                 // Add external drivers
                 rho_w_rhs(i, j, k) += ext_forcing[2];
@@ -921,9 +1036,12 @@ void erf_slow_rhs_pre (int /*level*/, int nrk,
         } // no terrain
         } // end profile
     } // mfi
+    } // omp
 
     if (l_use_diff) {
         delete expr;
+    }
+    if (l_use_diff && !l_fused_scalar) {
         delete dflux_x;
         delete dflux_y;
         delete dflux_z;
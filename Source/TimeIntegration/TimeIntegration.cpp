@@ -7,6 +7,7 @@
 #include <Diffusion.H>
 #include <ERF.H>
 #include <EOS.H>
+#include <Utils.H>
 
 using namespace amrex;
 
@@ -54,18 +55,24 @@ void ERF::erf_advance(int level,
     const BoxArray& ba_z          = zvel_old.boxArray();
     const DistributionMapping& dm = cons_old.DistributionMap();
 
-    MultiFab    S_prim  (ba  , dm, NUM_PRIM,          cons_old.nGrowVect());
-    MultiFab  pi_stage  (ba  , dm,        1,          cons_old.nGrowVect());
-    MultiFab fast_coeffs(ba_z, dm,        5,          0);
+    // Scratch data is drawn from (and returned to) the per-level pool so that
+    //    it is only allocated when the grids at this level change
+    ERFWorkspace& ws = *workspace[level];
+
+    MultiFab&    S_prim  = ws.acquire(ba  , dm, NUM_PRIM,          cons_old.nGrowVect());
+    MultiFab&  pi_stage  = ws.acquire(ba  , dm,        1,          cons_old.nGrowVect());
+    FastMultiFab& fast_coeffs = ws.acquire_fast(ba_z, dm, 5,
+                                                IntVect(solverChoice.fast_halo_depth-1,solverChoice.fast_halo_depth-1,0));
     MultiFab* eddyDiffs;
     if (l_use_kturb) {
-      eddyDiffs = new MultiFab(ba , dm, EddyDiff::NumDiffs, 1);
+      eddyDiffs = &ws.acquire(ba , dm, EddyDiff::NumDiffs, 1);
     } else {
       eddyDiffs = nullptr;
     }
 
     // **************************************************************************************
     // Compute strain for use in slow RHS, Smagorinsky model, and MOST
+    //    (with erf.use_tiled_stress these are instead made tile by tile where they are used)
     // **************************************************************************************
     BoxArray ba12 = convert(ba, IntVect(1,1,0));
     BoxArray ba13 = convert(ba, IntVect(1,0,1));
@@ -81,17 +88,17 @@ void ERF::erf_advance(int level,
     MultiFab* Tau32 = nullptr;
     {
     BL_PROFILE("erf_advance_strain");
-    if (l_use_diff) {
-        Tau11 = new MultiFab(ba  , dm, 1, IntVect(1,1,0));
-        Tau22 = new MultiFab(ba  , dm, 1, IntVect(1,1,0));
-        Tau33 = new MultiFab(ba  , dm, 1, IntVect(1,1,0));
-        Tau12 = new MultiFab(ba12, dm, 1, IntVect(1,1,0));
-        Tau13 = new MultiFab(ba13, dm, 1, IntVect(1,1,0));
-        Tau23 = new MultiFab(ba23, dm, 1, IntVect(1,1,0));
+    if (l_use_diff && !solverChoice.use_tiled_stress) {
+        Tau11 = &ws.acquire(ba  , dm, 1, IntVect(1,1,0));
+        Tau22 = &ws.acquire(ba  , dm, 1, IntVect(1,1,0));
+        Tau33 = &ws.acquire(ba  , dm, 1, IntVect(1,1,0));
+        Tau12 = &ws.acquire(ba12, dm, 1, IntVect(1,1,0));
+        Tau13 = &ws.acquire(ba13, dm, 1, IntVect(1,1,0));
+        Tau23 = &ws.acquire(ba23, dm, 1, IntVect(1,1,0));
         if (l_use_terrain) {
-            Tau21 = new MultiFab(ba12, dm, 1, IntVect(1,1,0));
-            Tau31 = new MultiFab(ba13, dm, 1, IntVect(1,1,0));
-            Tau32 = new MultiFab(ba23, dm, 1, IntVect(1,1,0));
+            Tau21 = &ws.acquire(ba12, dm, 1, IntVect(1,1,0));
+            Tau31 = &ws.acquire(ba13, dm, 1, IntVect(1,1,0));
+            Tau32 = &ws.acquire(ba23, dm, 1, IntVect(1,1,0));
         }
 
         const amrex::BCRec* bc_ptr_h = domain_bcs_type.data();
@@ -155,7 +162,24 @@ void ERF::erf_advance(int level,
     } // profile
 
 
-    MultiFab Omega (zmom_old.boxArray(),dm,1,1);
+    MultiFab& Omega = ws.acquire(zmom_old.boxArray(),dm,1,1);
+
+    // Passive tracers: with Eulerian transport every stage advances from tracers_old into
+    //    tracers_new or tr_buf, whichever does not hold the tracers at the start of the stage;
+    //    with semi-Lagrangian transport they are advanced once, after the last stage
+    const bool l_use_tracers = (solverChoice.num_tracers > 0);
+    const bool l_tracers_sl  = l_use_tracers &&
+        (solverChoice.tracer_transport == TracerTransportType::SemiLagrangian);
+    MultiFab* tr_buf = nullptr;
+    const MultiFab* tr_stage_in = nullptr;
+    const Vector<MultiFab>* tr_avg_mom = nullptr;
+    if (l_use_tracers) {
+        FillZeroGradientGhostCells(tracers_old[level], fine_geom);
+        tr_stage_in = &tracers_old[level];
+        if (!l_tracers_sl) {
+            tr_buf = &ws.acquire(ba, dm, solverChoice.num_tracers, tracers_old[level].nGrowVect());
+        }
+    }
 
 #include "TI_utils.H"
 
@@ -193,11 +217,12 @@ void ERF::erf_advance(int level,
     // *************************************************************************
     if (l_use_kturb)
     {
-        ComputeTurbulentViscosity(xvel_old, yvel_old,
-                                  *Tau11, *Tau22, *Tau33,
-                                  *Tau12, *Tau13, *Tau23,
+        ComputeTurbulentViscosity(xvel_old, yvel_old, zvel_old,
+                                  Tau11, Tau22, Tau33,
+                                  Tau12, Tau13, Tau23,
                                   state_old[IntVar::cons],
-                                  *eddyDiffs, fine_geom, *mapfac_u[level], *mapfac_v[level],
+                                  *eddyDiffs, fine_geom, z_phys_nd[level].get(), domain_bcs_type.data(),
+                                  *mapfac_m[level], *mapfac_u[level], *mapfac_v[level],
                                   solverChoice, m_most);
     }
 
@@ -247,25 +272,50 @@ void ERF::erf_advance(int level,
     mri_integrator.set_fast_rhs(fast_rhs_fun);
     mri_integrator.set_slow_fast_timestep_ratio(fixed_mri_dt_ratio > 0 ? fixed_mri_dt_ratio : dt_mri_ratio[level]);
     mri_integrator.set_no_substep(no_substep_fun);
+
+    if (adaptive_substepping) {
+        mri_integrator.set_fast_dt_estimate([&](const Vector<MultiFab>& S_data) -> Real
+        {
+            return estFastTimeStep(level, S_data);
+        });
+    }
     } // profile
 
     mri_integrator.advance(state_old, state_new, old_time, dt_advance);
 
-    if (l_use_kturb) delete eddyDiffs;
-
-    if (l_use_diff) {
-      delete Tau11;
-      delete Tau22;
-      delete Tau33;
-      delete Tau12;
-      delete Tau13;
-      delete Tau23;
-      if (l_use_terrain) {
-        delete Tau21;
-        delete Tau31;
-        delete Tau32;
-      }
+    // The vertical diffusion left out of the slow RHS (erf.use_implicit_vert_diff)
+    if (solverChoice.use_implicit_vert_diff && l_use_diff) {
+        ImplicitVertDiff_N(dt_advance, cons_new, xmom_new, ymom_new, xvel_new, yvel_new,
+                           eddyDiffs, fine_geom, solverChoice);
     }
 
+    if (l_tracers_sl) {
+        // The momenta averaged over the last stage, which spans the whole step
+        advance_tracers_sl(level, dt_advance, tracers_old[level], tracers_new[level],
+                           cons_old, *tr_avg_mom);
+    } else if (l_use_tracers && tr_stage_in == tr_buf) {
+        MultiFab::Copy(tracers_new[level], *tr_buf, 0, 0, solverChoice.num_tracers,
+                       tr_buf->nGrowVect());
+    }
+
+    if (verbose && adaptive_substepping) {
+        Print() << "Acoustic substeps per RK stage at level " << level << ":";
+        for (int nrk = 0; nrk < mri_integrator.num_stages(); ++nrk) {
+            Print() << " " << mri_integrator.get_nsubsteps(nrk);
+        }
+        Print() << std::endl;
+    }
+
+    // Hand the scratch data back to the pool for the next call
+    ws.release(S_prim);
+    ws.release(pi_stage);
+    ws.release(fast_coeffs);
+    ws.release(Omega);
+    ws.release(tr_buf);
+    ws.release(eddyDiffs);
+    ws.release(Tau11); ws.release(Tau22); ws.release(Tau33);
+    ws.release(Tau12); ws.release(Tau13); ws.release(Tau23);
+    ws.release(Tau21); ws.release(Tau31); ws.release(Tau32);
+
     if (verbose) Print() << "Done with advance at level " << level << std::endl;
 }
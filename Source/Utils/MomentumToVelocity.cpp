@@ -8,13 +8,14 @@
 using namespace amrex;
 
 /**
- * Convert updated momentum to updated velocity
+ * Convert updated momentum to updated velocity (on the faces selected by "faces")
  */
 void
 MomentumToVelocity( BoxArray& grids_to_evolve,
                     MultiFab& xvel, MultiFab& yvel, MultiFab& zvel,
                     const MultiFab& cons_in,
-                    const MultiFab& xmom_in, const MultiFab& ymom_in, const MultiFab& zmom_in)
+                    const MultiFab& xmom_in, const MultiFab& ymom_in, const MultiFab& zmom_in,
+                    FaceSet faces)
 {
     BL_PROFILE_VAR("MomentumToVelocity()",MomentumToVelocity);
 
@@ -29,9 +30,21 @@ MomentumToVelocity( BoxArray& grids_to_evolve,
         // Construct intersection of current tilebox and valid region for updating
         Box bx = mfi.tilebox() & valid_bx;
 
-        const Box& tbx = surroundingNodes(bx,0);
-        const Box& tby = surroundingNodes(bx,1);
-        const Box& tbz = surroundingNodes(bx,2);
+        Box tbx = surroundingNodes(bx,0);
+        Box tby = surroundingNodes(bx,1);
+        Box tbz = surroundingNodes(bx,2);
+
+        // Faces whose two neighboring cells are both valid
+        const Box ibx = surroundingNodes(valid_bx,0).grow(0,-1);
+        const Box iby = surroundingNodes(valid_bx,1).grow(1,-1);
+        const Box ibz = surroundingNodes(valid_bx,2).grow(2,-1);
+
+        if (faces == FaceSet::interior) {
+            tbx &= ibx;
+            tby &= iby;
+            tbz &= ibz;
+        }
+        const bool skip_interior = (faces == FaceSet::remainder);
 
         // Conserved variables on cell centers -- we use this for density
         const Array4<const Real>& cons = cons_in.array(mfi);
@@ -48,12 +61,15 @@ MomentumToVelocity( BoxArray& grids_to_evolve,
 
         amrex::ParallelFor(tbx, tby, tbz,
         [=] AMREX_GPU_DEVICE (int i, int j, int k) {
+            if (skip_interior && ibx.contains(IntVect(i,j,k))) return;
             velx(i,j,k) = momx(i,j,k)/(0.5 * (cons(i,j,k,Rho_comp) + cons(i-1,j,k,Rho_comp)));
         },
         [=] AMREX_GPU_DEVICE (int i, int j, int k) {
+            if (skip_interior && iby.contains(IntVect(i,j,k))) return;
             vely(i,j,k) = momy(i,j,k)/(0.5 * (cons(i,j,k,Rho_comp) + cons(i,j-1,k,Rho_comp)));
         },
         [=] AMREX_GPU_DEVICE (int i, int j, int k) {
+            if (skip_interior && ibz.contains(IntVect(i,j,k))) return;
             velz(i,j,k) = momz(i,j,k)/(0.5 * (cons(i,j,k,Rho_comp) + cons(i,j,k-1,Rho_comp)));
         });
     } // end MFIter
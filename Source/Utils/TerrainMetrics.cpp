@@ -454,3 +454,74 @@ make_zcc(const amrex::Geometry& geom,
     }
     z_phys_cc.FillBoundary(geom.periodicity());
 }
+
+//*****************************************************************************************
+// Compute the metric terms and detJ on the x-, y- and z-faces (see FaceMetric)
+//*****************************************************************************************
+void
+make_face_metrics (const amrex::Geometry& geom,
+                   const amrex::MultiFab& z_phys_nd,
+                   const amrex::MultiFab& detJ_cc,
+                   amrex::Vector<amrex::MultiFab>& face_metrics)
+{
+    BL_PROFILE("make_face_metrics()");
+
+    AMREX_ALWAYS_ASSERT(face_metrics.size() == AMREX_SPACEDIM);
+
+    const auto dxInv = geom.InvCellSizeArray();
+
+    // detJ_cc is not defined below the domain (see make_J)
+    int domlo_z = geom.Domain().smallEnd(2);
+
+    for (int dir = 0; dir < AMREX_SPACEDIM; ++dir)
+    {
+#ifdef _OPENMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+        for ( amrex::MFIter mfi(face_metrics[dir], amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi )
+        {
+            // The metric terms are defined on every face we hold, since z_nd has more ghost cells
+            amrex::Box gbx = mfi.growntilebox();
+
+            // The average of detJ is only defined where detJ_cc is on both sides of the face
+            amrex::Box jbx = detJ_cc[mfi].box();
+            jbx.setSmall(2, std::max(jbx.smallEnd(2), domlo_z));
+            jbx.surroundingNodes(dir);
+            jbx.grow(dir,-1);
+            amrex::Box dbx = gbx & jbx;
+
+            amrex::Array4<amrex::Real const> z_nd = z_phys_nd.const_array(mfi);
+            amrex::Array4<amrex::Real const> detJ = detJ_cc.const_array(mfi);
+            amrex::Array4<amrex::Real      > met  = face_metrics[dir].array(mfi);
+
+            if (dir == 0) {
+                amrex::ParallelFor(gbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+                    met(i,j,k,FaceMetric::h_xi  ) = Compute_h_xi_AtIface  (i,j,k,dxInv,z_nd);
+                    met(i,j,k,FaceMetric::h_eta ) = Compute_h_eta_AtIface (i,j,k,dxInv,z_nd);
+                    met(i,j,k,FaceMetric::h_zeta) = Compute_h_zeta_AtIface(i,j,k,dxInv,z_nd);
+                });
+                amrex::ParallelFor(dbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+                    met(i,j,k,FaceMetric::detJ) = 0.5*(detJ(i,j,k) + detJ(i-1,j,k));
+                });
+            } else if (dir == 1) {
+                amrex::ParallelFor(gbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+                    met(i,j,k,FaceMetric::h_xi  ) = Compute_h_xi_AtJface  (i,j,k,dxInv,z_nd);
+                    met(i,j,k,FaceMetric::h_eta ) = Compute_h_eta_AtJface (i,j,k,dxInv,z_nd);
+                    met(i,j,k,FaceMetric::h_zeta) = Compute_h_zeta_AtJface(i,j,k,dxInv,z_nd);
+                });
+                amrex::ParallelFor(dbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+                    met(i,j,k,FaceMetric::detJ) = 0.5*(detJ(i,j,k) + detJ(i,j-1,k));
+                });
+            } else {
+                amrex::ParallelFor(gbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+                    met(i,j,k,FaceMetric::h_xi  ) = Compute_h_xi_AtKface  (i,j,k,dxInv,z_nd);
+                    met(i,j,k,FaceMetric::h_eta ) = Compute_h_eta_AtKface (i,j,k,dxInv,z_nd);
+                    met(i,j,k,FaceMetric::h_zeta) = Compute_h_zeta_AtKface(i,j,k,dxInv,z_nd);
+                });
+                amrex::ParallelFor(dbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+                    met(i,j,k,FaceMetric::detJ) = 0.5*(detJ(i,j,k) + detJ(i,j,k-1));
+                });
+            }
+        }
+    }
+}
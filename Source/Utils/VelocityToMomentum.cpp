@@ -8,7 +8,7 @@
 using namespace amrex;
 
 /**
- * Convert velocity to momentum.
+ * Convert velocity to momentum (on the faces selected by "faces")
  */
 void VelocityToMomentum( const MultiFab& xvel_in,
                          const IntVect& xvel_ngrow,
@@ -17,7 +17,8 @@ void VelocityToMomentum( const MultiFab& xvel_in,
                          const MultiFab& zvel_in,
                          const IntVect& zvel_ngrow,
                          const MultiFab& cons_in,
-                         MultiFab& xmom, MultiFab& ymom, MultiFab& zmom)
+                         MultiFab& xmom, MultiFab& ymom, MultiFab& zmom,
+                         FaceSet faces)
 {
     BL_PROFILE_VAR("VelocityToMomentum()",VelocityToMomentum);
 
@@ -31,6 +32,19 @@ void VelocityToMomentum( const MultiFab& xvel_in,
         Box tby = amrex::grow(mfi.nodaltilebox(1),yvel_ngrow); tby.setSmall(2,0);
         Box tbz = amrex::grow(mfi.nodaltilebox(2),zvel_ngrow); tbz.setSmall(2,0);
 
+        // Faces whose two neighboring cells are both valid
+        const Box& valid_bx = mfi.validbox();
+        const Box ibx = surroundingNodes(valid_bx,0).grow(0,-1);
+        const Box iby = surroundingNodes(valid_bx,1).grow(1,-1);
+        const Box ibz = surroundingNodes(valid_bx,2).grow(2,-1);
+
+        if (faces == FaceSet::interior) {
+            tbx &= ibx;
+            tby &= iby;
+            tbz &= ibz;
+        }
+        const bool skip_interior = (faces == FaceSet::remainder);
+
         // Conserved/state variables on cell centers -- we use this for density
         const Array4<const Real>& cons = cons_in.array(mfi);
 
@@ -46,12 +60,15 @@ void VelocityToMomentum( const MultiFab& xvel_in,
 
         amrex::ParallelFor(tbx, tby, tbz,
         [=] AMREX_GPU_DEVICE (int i, int j, int k) {
+            if (skip_interior && ibx.contains(IntVect(i,j,k))) return;
             momx(i,j,k) = velx(i,j,k) * 0.5 * (cons(i,j,k,Rho_comp) + cons(i-1,j,k,Rho_comp));
         },
         [=] AMREX_GPU_DEVICE (int i, int j, int k) {
+            if (skip_interior && iby.contains(IntVect(i,j,k))) return;
             momy(i,j,k) = vely(i,j,k) * 0.5 * (cons(i,j,k,Rho_comp) + cons(i,j-1,k,Rho_comp));
         },
         [=] AMREX_GPU_DEVICE (int i, int j, int k) {
+            if (skip_interior && ibz.contains(IntVect(i,j,k))) return;
             momz(i,j,k) = velz(i,j,k) * 0.5 * (cons(i,j,k,Rho_comp) + cons(i,j,k-1,Rho_comp));
         });
     } // end MFIter
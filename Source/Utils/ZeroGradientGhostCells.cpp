@@ -0,0 +1,51 @@
+/**
+ * \file ZeroGradientGhostCells.cpp
+ */
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <Utils.H>
+
+using namespace amrex;
+
+/**
+ * Fill the ghost cells of a cell-centered MultiFab: from the neighboring grids (and periodic
+ * images) inside the domain, and with the value of the nearest valid cell outside the domain
+ */
+void
+FillZeroGradientGhostCells (MultiFab& mf, const Geometry& geom)
+{
+    BL_PROFILE_VAR("FillZeroGradientGhostCells()",FillZeroGradientGhostCells);
+
+    mf.FillBoundary(geom.periodicity());
+
+    const Box& domain = geom.Domain();
+    const auto dom_lo = lbound(domain);
+    const auto dom_hi = ubound(domain);
+
+    const Box gdomain = geom.growPeriodicDomain(mf.nGrow());
+    const GpuArray<int,AMREX_SPACEDIM> is_per = {AMREX_D_DECL(geom.isPeriodic(0),
+                                                              geom.isPeriodic(1),
+                                                              geom.isPeriodic(2))};
+    const int ncomp = mf.nComp();
+
+#ifdef _OPENMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+    {
+        const Box& gbx = mfi.fabbox();
+        if (gdomain.contains(gbx)) continue;
+
+        const Array4<Real>& arr = mf.array(mfi);
+
+        amrex::ParallelFor(gbx, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+        {
+            if (!gdomain.contains(IntVect(AMREX_D_DECL(i,j,k)))) {
+                int ii = is_per[0] ? i : amrex::min(amrex::max(i, dom_lo.x), dom_hi.x);
+                int jj = is_per[1] ? j : amrex::min(amrex::max(j, dom_lo.y), dom_hi.y);
+                int kk = is_per[2] ? k : amrex::min(amrex::max(k, dom_lo.z), dom_hi.z);
+                arr(i,j,k,n) = arr(ii,jj,kk,n);
+            }
+        });
+    } // mfi
+}
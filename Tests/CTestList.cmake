@@ -9,9 +9,13 @@ set(FCOMPARE_GOLD_FILES_DIRECTORY ${CMAKE_CURRENT_SOURCE_DIR}/ERF-WindGoldFiles)
 # Functions for adding tests / Categories of tests
 #=============================================================================
 macro(setup_test)
-    set(CURRENT_TEST_SOURCE_DIR ${CMAKE_CURRENT_SOURCE_DIR}/test_files/${TEST_NAME})
+    # A variant test runs the input of, and compares against the gold files of, its base test
+    if(NOT BASE_TEST)
+        set(BASE_TEST ${TEST_NAME})
+    endif()
+    set(CURRENT_TEST_SOURCE_DIR ${CMAKE_CURRENT_SOURCE_DIR}/test_files/${BASE_TEST})
     set(CURRENT_TEST_BINARY_DIR ${CMAKE_CURRENT_BINARY_DIR}/test_files/${TEST_NAME})
-    set(PLOT_GOLD ${FCOMPARE_GOLD_FILES_DIRECTORY}/${TEST_NAME})
+    set(PLOT_GOLD ${FCOMPARE_GOLD_FILES_DIRECTORY}/${BASE_TEST})
 
     file(MAKE_DIRECTORY ${CURRENT_TEST_BINARY_DIR})
     file(GLOB TEST_FILES "${CURRENT_TEST_SOURCE_DIR}/*")
@@ -51,6 +55,76 @@ function(add_test_r TEST_NAME TEST_EXE PLTFILE)
     )
 endfunction(add_test_r)
 
+# Regression test of an alternative code path that must reproduce an existing test:
+# runs the input file of BASE_TEST with OPTIONS added on the command line, and
+# compares against the gold files of BASE_TEST
+function(add_test_r_variant TEST_NAME BASE_TEST TEST_EXE PLTFILE OPTIONS)
+    setup_test()
+
+    set(TEST_EXE ${CMAKE_BINARY_DIR}/Exec/${TEST_EXE})
+    set(FCOMPARE_TOLERANCE "-r 1e-12 --abs_tol 1.0e-12")
+    set(FCOMPARE_FLAGS "-a ${FCOMPARE_TOLERANCE}")
+    set(test_command sh -c "${MPI_COMMANDS} ${TEST_EXE} ${CURRENT_TEST_BINARY_DIR}/${BASE_TEST}.i ${RUNTIME_OPTIONS} ${OPTIONS} > ${TEST_NAME}.log && ${FCOMPARE_EXE} ${FCOMPARE_FLAGS} ${PLOT_GOLD} ${CURRENT_TEST_BINARY_DIR}/${PLTFILE}")
+
+    add_test(${TEST_NAME} ${test_command})
+    set_tests_properties(${TEST_NAME}
+        PROPERTIES
+        TIMEOUT 5400
+        PROCESSORS ${NP}
+        WORKING_DIRECTORY "${CURRENT_TEST_BINARY_DIR}/"
+        LABELS "regression"
+        ATTACHED_FILES_ON_FAIL "${CURRENT_TEST_BINARY_DIR}/${TEST_NAME}.log"
+    )
+endfunction(add_test_r_variant)
+
+# Regression test of an alternative code path that must give the same answer as the default
+# one, on an input that has no gold files: runs the input file of BASE_TEST with and without
+# OPTIONS added on the command line, and compares the two plotfiles. An optional sixth
+# argument replaces the fcompare tolerance, for paths that only agree to truncation error
+function(add_test_r_same TEST_NAME BASE_TEST TEST_EXE PLTFILE OPTIONS)
+    setup_test()
+
+    set(TEST_EXE ${CMAKE_BINARY_DIR}/Exec/${TEST_EXE})
+    set(FCOMPARE_TOLERANCE "-r 1e-12 --abs_tol 1.0e-12")
+    if(ARGC GREATER 5)
+        set(FCOMPARE_TOLERANCE "${ARGV5}")
+    endif()
+    set(FCOMPARE_FLAGS "-a ${FCOMPARE_TOLERANCE}")
+    set(test_command sh -c "mkdir -p default && cd default && ${MPI_COMMANDS} ${TEST_EXE} ${CURRENT_TEST_BINARY_DIR}/${BASE_TEST}.i ${RUNTIME_OPTIONS} > ${TEST_NAME}_default.log && cd .. && ${MPI_COMMANDS} ${TEST_EXE} ${CURRENT_TEST_BINARY_DIR}/${BASE_TEST}.i ${RUNTIME_OPTIONS} ${OPTIONS} > ${TEST_NAME}.log && ${FCOMPARE_EXE} ${FCOMPARE_FLAGS} default/${PLTFILE} ${CURRENT_TEST_BINARY_DIR}/${PLTFILE}")
+
+    add_test(${TEST_NAME} ${test_command})
+    set_tests_properties(${TEST_NAME}
+        PROPERTIES
+        TIMEOUT 5400
+        PROCESSORS ${NP}
+        WORKING_DIRECTORY "${CURRENT_TEST_BINARY_DIR}/"
+        LABELS "regression"
+        ATTACHED_FILES_ON_FAIL "${CURRENT_TEST_BINARY_DIR}/${TEST_NAME}.log"
+    )
+endfunction(add_test_r_same)
+
+# Writes the boundary planes an add_test_r_same test reads before either of its runs: runs
+# INPUT in default/ and then in the test directory with OPTIONS added. The planes must go to
+# BndryFiles, which is removed first since time.dat is appended to
+function(add_test_r_same_bndry_planes TEST_NAME BASE_TEST TEST_EXE INPUT OPTIONS)
+    setup_test()
+
+    set(TEST_EXE ${CMAKE_BINARY_DIR}/Exec/${TEST_EXE})
+    set(test_command sh -c "rm -rf default/BndryFiles BndryFiles && mkdir -p default && cd default && ${MPI_COMMANDS} ${TEST_EXE} ${CURRENT_TEST_BINARY_DIR}/${INPUT} ${RUNTIME_OPTIONS} > ${TEST_NAME}_setup_default.log && cd .. && ${MPI_COMMANDS} ${TEST_EXE} ${CURRENT_TEST_BINARY_DIR}/${INPUT} ${RUNTIME_OPTIONS} ${OPTIONS} > ${TEST_NAME}_setup.log")
+
+    add_test(${TEST_NAME}_setup ${test_command})
+    set_tests_properties(${TEST_NAME}_setup
+        PROPERTIES
+        TIMEOUT 5400
+        PROCESSORS ${NP}
+        WORKING_DIRECTORY "${CURRENT_TEST_BINARY_DIR}/"
+        LABELS "regression"
+        FIXTURES_SETUP ${TEST_NAME}
+        ATTACHED_FILES_ON_FAIL "${CURRENT_TEST_BINARY_DIR}/${TEST_NAME}_setup.log"
+    )
+    set_tests_properties(${TEST_NAME} PROPERTIES FIXTURES_REQUIRED ${TEST_NAME})
+endfunction(add_test_r_same_bndry_planes)
+
 # Standard unit test
 function(add_test_u TEST_NAME)
     setup_test()
@@ -99,6 +173,44 @@ add_test_r(Bubble_DensityCurrent             "Bubble/bubble" "plt00010")
 add_test_r(MSF_NoSub_IsentropicVortexAdv     "IsentropicVortex/erf_isentropic_vortex" "plt00010")
 add_test_r(MSF_Sub_IsentropicVortexAdv       "IsentropicVortex/erf_isentropic_vortex" "plt00010")
 
+#=============================================================================
+# Alternative code paths that must reproduce an existing test
+#=============================================================================
+add_test_r_variant(DensityCurrent_fused              DensityCurrent              "DensityCurrent/density_current" "plt00010" "erf.use_fused_fast_rhs=true")
+add_test_r_variant(MSF_Sub_IsentropicVortexAdv_fused MSF_Sub_IsentropicVortexAdv "IsentropicVortex/erf_isentropic_vortex" "plt00010" "erf.use_fused_fast_rhs=true")
+add_test_r_variant(DensityCurrent_split_phase        DensityCurrent              "DensityCurrent/density_current" "plt00010" "erf.use_split_phase_fill=true")
+add_test_r_variant(DensityCurrent_deep_halo          DensityCurrent              "DensityCurrent/density_current" "plt00010" "erf.fast_halo_depth=2")
+add_test_r_variant(ScalarAdvDiff_order5_mapfactor    ScalarAdvDiff_order5        "ScalarAdvDiff/erf_scalar_advdiff" "plt00020" "erf.use_mapfactor=true")
+add_test_r_variant(ScalarAdvDiff_order5_tracers     ScalarAdvDiff_order5        "ScalarAdvDiff/erf_scalar_advdiff" "plt00020" "erf.num_tracers=4")
+add_test_r_variant(ScalarAdvDiff_order5_tracers_sl  ScalarAdvDiff_order5        "ScalarAdvDiff/erf_scalar_advdiff" "plt00020" "erf.num_tracers=4 erf.tracer_transport=SemiLagrangian")
+add_test_r_variant(IsentropicVortexAdvecting_custom_mri IsentropicVortexAdvecting "IsentropicVortex/erf_isentropic_vortex" "plt00010" "erf.mri_scheme=Custom erf.mri_butcher_a=0.3333333333333333 0.0 0.5 erf.mri_butcher_b=0.0 0.0 1.0")
+add_test_r_variant(DensityCurrent_fused_scalar       DensityCurrent              "DensityCurrent/density_current" "plt00010" "erf.use_fused_scalar_rhs=true")
+add_test_r_variant(ScalarAdvDiff_order5_fused_scalar ScalarAdvDiff_order5        "ScalarAdvDiff/erf_scalar_advdiff" "plt00020" "erf.use_fused_scalar_rhs=true")
+add_test_r_variant(DensityCurrent_fused_mom          DensityCurrent              "DensityCurrent/density_current" "plt00010" "erf.use_fused_mom_rhs=true")
+add_test_r_variant(EkmanSpiral_fused_mom             EkmanSpiral                 "EkmanSpiral_custom/ekman_spiral_custom" "plt00010" "erf.use_fused_mom_rhs=true")
+add_test_r_variant(DensityCurrent_detJ2_metric_cache DensityCurrent_detJ2        "DensityCurrent/density_current" "plt00010" "erf.use_metric_cache=true")
+add_test_r_variant(DensityCurrent_detJ2_MT_metric_cache DensityCurrent_detJ2_MT     "DensityCurrent/density_current" "plt00010" "erf.use_metric_cache=true")
+add_test_r_variant(DensityCurrent_tiled_stress       DensityCurrent              "DensityCurrent/density_current" "plt00010" "erf.use_tiled_stress=true")
+add_test_r_variant(DensityCurrent_detJ2_tiled_stress DensityCurrent_detJ2        "DensityCurrent/density_current" "plt00010" "erf.use_tiled_stress=true")
+add_test_r_variant(EkmanSpiral_tiled_stress          EkmanSpiral                 "EkmanSpiral_custom/ekman_spiral_custom" "plt00010" "erf.use_tiled_stress=true")
+add_test_r_variant(ScalarDiffusionSine_implicit_vert_diff ScalarDiffusionSine   "ScalarAdvDiff/erf_scalar_advdiff" "plt00020" "erf.use_implicit_vert_diff=true")
+add_test_r_variant(DensityCurrent_aggregated_fill    DensityCurrent              "DensityCurrent/density_current" "plt00010" "erf.use_aggregated_fill=true")
+add_test_r_variant(DensityCurrent_fill_tracking      DensityCurrent              "DensityCurrent/density_current" "plt00010" "erf.use_fill_tracking=true")
+
+#=============================================================================
+# Alternative code paths checked against the default path, on inputs without gold files
+#=============================================================================
+add_test_r_same(ScalarAdvDiff_tracers ScalarAdvDiff_tracers "ScalarAdvDiff/erf_scalar_advdiff" "plt00020" "erf.num_tracers=16")
+add_test_r_same(ScalarAdvDiff_tracers_sl ScalarAdvDiff_tracers_sl "ScalarAdvDiff/erf_scalar_advdiff" "plt00020" "erf.num_tracers=16")
+add_test_r_same(DensityCurrent_hevi DensityCurrent_hevi "DensityCurrent/density_current" "plt00010" "erf.no_substepping=2 erf.adaptive_substepping=0")
+add_test_r_same(IsentropicVortexAdvecting_rk4 IsentropicVortexAdvecting_rk4 "IsentropicVortex/erf_isentropic_vortex" "plt00010" "erf.mri_scheme=Custom erf.mri_butcher_a=0.5 0.0 0.5 0.0 0.0 1.0 erf.mri_butcher_b=0.1666666666666667 0.3333333333333333 0.3333333333333333 0.1666666666666667")
+add_test_r_same(ABL_MYNN_implicit_vert_diff ABL_MYNN_implicit_vert_diff "ABL/erf_abl" "plt00010" "amr.max_grid_size_x=8 amr.max_grid_size_y=8")
+add_test_r_same(ABL_anelastic_tiled_stress ABL_anelastic "ABL/erf_abl" "plt00010" "erf.use_tiled_stress=true")
+add_test_r_same(ABL_anelastic_fused_mom ABL_anelastic "ABL/erf_abl" "plt00010" "erf.use_fused_mom_rhs=true")
+add_test_r_same(DensityCurrent_refined_fill_patcher DensityCurrent_refined "DensityCurrent/density_current" "plt00010" "erf.use_fill_patcher=true" "-r 1e-6")
+add_test_r_same(ABL_bndry_planes_binary ABL_bndry_planes_binary "ABL/erf_abl" "plt00010" "erf.bndry_file_format=binary")
+add_test_r_same_bndry_planes(ABL_bndry_planes_binary ABL_bndry_planes_binary "ABL/erf_abl" "ABL_bndry_planes_binary_write.i" "erf.bndry_output_planes_format=binary")
+
 #=============================================================================
 # Performance tests
 #=============================================================================
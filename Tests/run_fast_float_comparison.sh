@@ -0,0 +1,58 @@
+#!/bin/bash
+#
+# Compare the mixed-precision acoustic substep (ERF_ENABLE_FAST_FLOAT / USE_FAST_FLOAT)
+# with the double precision one on the regression problems that use substepping without
+# terrain. Each problem is run with both builds; we report the time spent in the fast RHS
+# and the differences between the two final plotfiles. Both builds must have tiny profiling
+# enabled (ERF_ENABLE_TINY_PROFILE / TINY_PROFILE = TRUE).
+#
+# Usage: ./run_fast_float_comparison.sh <double build dir> <float build dir> <fcompare> [mpirun prefix]
+#
+# where the build directories are CMake build trees (the executables are in <dir>/Exec).
+
+build_double="$1"
+build_float="$2"
+fcompare="$3"
+launcher="$4"
+
+if [[ -z "$build_double" || -z "$build_float" || -z "$fcompare" ]]; then
+    echo "Usage: $0 <double build dir> <float build dir> <fcompare> [mpirun prefix]"
+    exit 1
+fi
+
+test_files=`cd $(dirname $0)/test_files && pwd`
+
+run_case()
+{
+    name="$1"
+    exe="$2"
+    pltfile="$3"
+
+    for precision in double float; do
+        if [[ "$precision" == "double" ]]; then
+            build="$build_double"
+        else
+            build="$build_float"
+        fi
+        rundir="$name.$precision"
+        rm -rf $rundir && mkdir $rundir
+        (cd $rundir && $launcher $build/Exec/$exe $test_files/$name/$name.i erf.check_int=-1 &> $name.log)
+        lastline=`tail -n 1 $rundir/$name.log`
+        if [[ "$lastline" != "AMReX"*"finalized" ]]; then
+            echo "Case $name ($precision) failed"
+            exit 1
+        fi
+        # Inclusive time (max over ranks) of the acoustic substeps
+        time=`grep "^fast_rhs_fun " $rundir/$name.log | tail -n 1 | awk '{print $5}'`
+        echo "$name ($precision): $time s in fast_rhs_fun"
+    done
+
+    # Absolute and relative differences of every variable of the final plotfile
+    $fcompare $name.double/$pltfile $name.float/$pltfile
+    echo
+}
+
+run_case DensityCurrent              DensityCurrent/density_current          plt00010
+run_case IsentropicVortexStationary  IsentropicVortex/erf_isentropic_vortex  plt00010
+run_case IsentropicVortexAdvecting   IsentropicVortex/erf_isentropic_vortex  plt00010
+run_case MSF_Sub_IsentropicVortexAdv IsentropicVortex/erf_isentropic_vortex  plt00010